@@ -17,5 +17,8 @@ public class Cpp_InventorySystem : ModuleRules
 			"Slate", 
 			"UMG"
 		});
+
+		// FImage resizing for the icon atlas commandlet
+		PrivateDependencyModuleNames.AddRange(new string[] { "ImageCore" });
 	}
 }
@@ -4,9 +4,14 @@
 #include "TimerManager.h"
 #include "UI/Cpp_InventoryHUD.h"
 #include "Components/Cpp_AC_Inventory.h"
+#include "Components/Cpp_AC_ItemEffects.h"
 #include "World/Pickup.h"
+#include "World/LootContainer.h"
 #include "ItemBase.h"
 #include "Components/TimelineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Subsystems/Cpp_InteractionTimerSubsystem.h"
+#include "Subsystems/Cpp_PickupSpawnSubsystem.h"
 
 // Engine
 #include "EnhancedInputComponent.h"
@@ -55,6 +60,9 @@ ACpp_InventorySystemCharacter::ACpp_InventorySystemCharacter()
 	PlayerInventory->SetSlotsCapacity(20);
 	PlayerInventory->SetWeightCapacity(50.0f);
 
+	ItemEffects = CreateDefaultSubobject<UCpp_AC_ItemEffects>(TEXT("ItemEffects"));
+	LootBagClass = ALootContainer::StaticClass();
+
 	// Create a follow camera
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
@@ -87,6 +95,7 @@ void ACpp_InventorySystemCharacter::BeginPlay() {
 	}
 
 	HUD = Cast<ACpp_InventoryHUD>(GetWorld()->GetFirstPlayerController()->GetHUD());
+	InteractionTimers = GetWorld()->GetSubsystem<UCpp_InteractionTimerSubsystem>();
 
 	// Sets up Timeline Functions and variables for Aiming
 	FOnTimelineFloat AimLerpAlphaValue;
@@ -140,6 +149,14 @@ void ACpp_InventorySystemCharacter::SetupPlayerInputComponent(UInputComponent* P
 }
 
 
+bool ACpp_InventorySystemCharacter::IsInteracting() const {
+	return InteractionTimers && InteractionTimers->IsInteractionActive(InteractionTimerHandle);
+}
+
+float ACpp_InventorySystemCharacter::GetInteractionProgress() const {
+	return InteractionTimers ? InteractionTimers->GetInteractionProgress(InteractionTimerHandle) : 0.0f;
+}
+
 void ACpp_InventorySystemCharacter::UpdateInteractionWidget() const {
 	if(IsValid(TargetInteractable.GetObject())) {
 		HUD->UpdateInteractionWidget(&TargetInteractable->InteractableData);
@@ -147,25 +164,116 @@ void ACpp_InventorySystemCharacter::UpdateInteractionWidget() const {
 }
 void ACpp_InventorySystemCharacter::DropItem(UItemBase* ItemToDrop, int32 QuantityToDrop) {
 	if (PlayerInventory->FindMatchingItem(ItemToDrop)) {
-		FActorSpawnParameters SpawnParams; // Struct that defines how the actor should be spawned
-		SpawnParams.Owner = this;
-		SpawnParams.bNoFail = true; // always spawn the actor
-		// Adjust the spawn location to avoid collision but always spawn the actor
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn; 
-		
-		const FVector SpawnLocation = GetActorLocation() + GetActorForwardVector() * 50.0f;
-		const FTransform SpawnTransform = FTransform(GetActorRotation(), SpawnLocation);
-
-		const int32 RemovedQuantity = PlayerInventory->RemoveAmountOfItem(ItemToDrop, QuantityToDrop);
+		UItemBase* DroppedItem = ItemToDrop;
+		int32 RemovedQuantity = FMath::Min(QuantityToDrop, ItemToDrop->Quantity);
+		if (RemovedQuantity >= ItemToDrop->Quantity) {
+			// The whole stack is dropped, take it out while it still has its quantity so it isn't recycled as an empty stack
+			PlayerInventory->RemoveSingleInstanceOfItem(ItemToDrop);
+		}
+		else {
+			// Part of the stack stays in the inventory so the pickup needs its own item, otherwise both would share one stack
+			RemovedQuantity = PlayerInventory->RemoveAmountOfItem(ItemToDrop, QuantityToDrop);
+			DroppedItem = ItemToDrop->CreateItemCopy();
+		}
 
-		APickup* Pickup = GetWorld()->SpawnActor<APickup>(APickup::StaticClass(), SpawnTransform, SpawnParams);
-		Pickup->InitializeDrop(ItemToDrop, RemovedQuantity);
+		// The pickup holding it is spawned within the spawn queue's frame budget, the item is kept alive until then
+		UCpp_PickupSpawnSubsystem::SpawnDrop(GetWorld(), DroppedItem, RemovedQuantity, GetDropTransform(), this);
 	}
 	else {
 		UE_LOG(LogTemplateCharacter, Warning, TEXT("Item not found in inventory somehow!"));
 	}
 }
 
+void ACpp_InventorySystemCharacter::DropItems(TConstArrayView<UItemBase*> ItemsToDrop) {
+	int32 NumStacks = 0;
+	float TotalWeight = 0.0f;
+	UItemBase* LastStack = nullptr;
+	for (UItemBase* ItemToDrop : ItemsToDrop) {
+		if (ItemToDrop && ItemToDrop->OwningInventory == PlayerInventory) {
+			++NumStacks;
+			TotalWeight += ItemToDrop->GetItemStackWeight();
+			LastStack = ItemToDrop;
+		}
+	}
+
+	// A lone stack stays a pickup, it can still merge with the pickups around it
+	if (NumStacks <= 1) {
+		if (LastStack) {
+			DropItem(LastStack, LastStack->Quantity);
+		}
+		return;
+	}
+
+	ALootContainer* LootBag = SpawnLootBag(NumStacks, TotalWeight);
+	if (!LootBag) {
+		// Copied, dropping the stacks changes the inventory ItemsToDrop may still be pointing into
+		const TArray<UItemBase*> Stacks(ItemsToDrop);
+		for (UItemBase* ItemToDrop : Stacks) {
+			if (ItemToDrop && ItemToDrop->OwningInventory == PlayerInventory) {
+				DropItem(ItemToDrop, ItemToDrop->Quantity);
+			}
+		}
+		return;
+	}
+	UCpp_AC_Inventory* LootBagInventory = LootBag->GetOrCreateContainerInventory();
+	{
+		// Both inventories broadcast once for the whole drop
+		FInventoryUpdateBatch PlayerBatch(PlayerInventory);
+		FInventoryUpdateBatch LootBagBatch(LootBagInventory);
+		for (UItemBase* ItemToDrop : ItemsToDrop) {
+			if (ItemToDrop && ItemToDrop->OwningInventory == PlayerInventory) {
+				PlayerInventory->TransferItem(ItemToDrop, LootBagInventory, ItemToDrop->Quantity);
+			}
+		}
+	}
+	LootBag->UpdateInteractableData();
+}
+
+void ACpp_InventorySystemCharacter::DropAllItems() {
+	if (PlayerInventory->IsEmpty()) {
+		return;
+	}
+
+	ALootContainer* LootBag = SpawnLootBag(PlayerInventory->GetNumItems(), PlayerInventory->GetInventoryTotalWeight());
+	if (!LootBag) {
+		for (UItemBase* ItemToDrop : PlayerInventory->GetInventoryContents()) {
+			DropItem(ItemToDrop, ItemToDrop->Quantity);
+		}
+		return;
+	}
+	PlayerInventory->TransferAll(LootBag->GetOrCreateContainerInventory());
+	LootBag->UpdateInteractableData();
+}
+
+FTransform ACpp_InventorySystemCharacter::GetDropTransform() const {
+	const FVector SpawnLocation = GetActorLocation() + GetActorForwardVector() * 50.0f;
+	return FTransform(GetActorRotation(), SpawnLocation);
+}
+
+ALootContainer* ACpp_InventorySystemCharacter::SpawnLootBag(const int32 NumStacks, const float TotalWeight) {
+	const TSubclassOf<ALootContainer> BagClass = LootBagClass ? LootBagClass : TSubclassOf<ALootContainer>(ALootContainer::StaticClass());
+	// An invisible bag without collision can't be focused, everything dropped into it would be lost
+	if (!BagClass.GetDefaultObject()->GetContainerMesh()->GetStaticMesh()) {
+		UE_LOG(LogTemplateCharacter, Error, TEXT("Loot bag class %s has no mesh, dropping the stacks as pickups instead!"), *BagClass->GetName());
+		return nullptr;
+	}
+	// Deferred so the bag simulates before BeginPlay, the significance subsystem restores what it finds there
+	const FTransform DropTransform = GetDropTransform();
+	ALootContainer* LootBag = GetWorld()->SpawnActorDeferred<ALootContainer>(BagClass, DropTransform, this, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	LootBag->GetContainerMesh()->SetSimulatePhysics(true);
+	LootBag->SetDestroyWhenEmpty(true);
+	LootBag->FinishSpawning(DropTransform);
+	LootBag->ReserveCapacity(NumStacks, TotalWeight);
+	return LootBag;
+}
+
+int32 ACpp_InventorySystemCharacter::UseItem(UItemBase* ItemToUse, const int32 Amount) {
+	if (PlayerInventory->FindMatchingItem(ItemToUse)) {
+		return ItemEffects->UseItem(ItemToUse, Amount);
+	}
+	return 0;
+}
+
 void ACpp_InventorySystemCharacter::PerformInteractionCheck() {
 	InteractionData.LastInteractionCheckTime = GetWorld()->GetTimeSeconds();
 
@@ -218,15 +326,16 @@ void ACpp_InventorySystemCharacter::FoundInteractable(AActor* NewInteractable) {
 	InteractionData.CurrentInteractable = NewInteractable;
 	TargetInteractable = NewInteractable;
 
-	HUD->UpdateInteractionWidget(&TargetInteractable->InteractableData);
-
-	// Begin focus on new interactable
+	// Begin focus on new interactable, before the widget is updated since containers only roll their contents now
 	TargetInteractable->BeginFocus();
+
+	HUD->UpdateInteractionWidget(&TargetInteractable->InteractableData);
 }
 void ACpp_InventorySystemCharacter::NoInteractableFound() {
 	// If char is interacting with something, end the interaction
 	if(IsInteracting()) {
-		GetWorldTimerManager().ClearTimer(TimerHandleInteraction);
+		InteractionTimers->CancelInteraction(InteractionTimerHandle);
+		OnInteractionProgress(0.0f);
 	}
 	if (InteractionData.CurrentInteractable) {
 		// Remove focus from old interactable Incase it was destroyed right after being added
@@ -252,21 +361,21 @@ void ACpp_InventorySystemCharacter::BeginInteract() {
 			if(FMath::IsNearlyZero(TargetInteractable->InteractableData.InteractionDuration, 0.1f)) {
 				ACpp_InventorySystemCharacter::Interact();
 			}
-			else {
-				// Set a timer to call the Interact function after the interaction duration
-				GetWorldTimerManager().SetTimer(TimerHandleInteraction,
-												this,
-												&ACpp_InventorySystemCharacter::Interact,
-												TargetInteractable->InteractableData.InteractionDuration, 
-												false);
-
-			} // Bug was fixed by re-adding the include for TimerManager.h
+			else if (InteractionTimers) {
+				// Call the Interact function after the interaction duration, timed by the world's interaction timer wheel
+				InteractionTimers->CancelInteraction(InteractionTimerHandle);
+				InteractionTimerHandle = InteractionTimers->StartInteraction(TargetInteractable->InteractableData.InteractionDuration,
+													FSimpleDelegate::CreateUObject(this, &ACpp_InventorySystemCharacter::Interact),
+													FOnInteractionProgress::CreateUObject(this, &ACpp_InventorySystemCharacter::OnInteractionProgress));
+			}
 		}
 	}
 }
 void ACpp_InventorySystemCharacter::EndInteract() {
 	// Clear the timer
-	GetWorldTimerManager().ClearTimer(TimerHandleInteraction);
+	if (InteractionTimers && InteractionTimers->CancelInteraction(InteractionTimerHandle)) {
+		OnInteractionProgress(0.0f);
+	}
 
 	if(IsValid(TargetInteractable.GetObject())) {
 		TargetInteractable->EndInteract();
@@ -275,13 +384,21 @@ void ACpp_InventorySystemCharacter::EndInteract() {
 }
 void ACpp_InventorySystemCharacter::Interact() {
 	// Clear the timer
-	GetWorldTimerManager().ClearTimer(TimerHandleInteraction);
+	if (InteractionTimers) {
+		InteractionTimers->CancelInteraction(InteractionTimerHandle);
+	}
 
 	if(IsValid(TargetInteractable.GetObject())) {
 		TargetInteractable->Interact(this);
 	}
 }
 
+void ACpp_InventorySystemCharacter::OnInteractionProgress(const float Progress) {
+	if (HUD) {
+		HUD->UpdateInteractionProgress(Progress);
+	}
+}
+
 void ACpp_InventorySystemCharacter::ToggleMenu() {
 	HUD->ToggleMenu();
 	if (HUD->bIsMenuVisible) {
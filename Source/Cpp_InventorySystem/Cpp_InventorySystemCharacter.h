@@ -7,6 +7,7 @@
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
 #include "Interfaces/InteractionInterface.h"
+#include "Utils/Cpp_TimerWheel.h"
 #include "Cpp_InventorySystemCharacter.generated.h"
 
 
@@ -32,8 +33,11 @@ class UInputMappingContext;
 class UInputAction;
 struct FInputActionValue;
 class UCpp_AC_Inventory;
+class UCpp_AC_ItemEffects;
 class UItemBase;
 class UTimelineComponent;
+class UCpp_InteractionTimerSubsystem;
+class ALootContainer;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
@@ -62,14 +66,26 @@ public:
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
 
 	// Returns whether the character is currently interacting with an interactable
-	FORCEINLINE bool IsInteracting() const { return GetWorldTimerManager().IsTimerActive(TimerHandleInteraction); }
+	bool IsInteracting() const;
+	// How far along the current timed interaction is, 0 when not interacting
+	float GetInteractionProgress() const;
 
 	FORCEINLINE UCpp_AC_Inventory* GetInventory() const { return PlayerInventory; }
 
+	FORCEINLINE UCpp_AC_ItemEffects* GetItemEffects() const { return ItemEffects; }
+
 	// Called when the character interacts with an interactable to update the interaction widget
 	void UpdateInteractionWidget() const;
 
 	void DropItem(UItemBase* ItemToDrop, int32 QuantityToDrop);
+	// Drops whole stacks into a single loot bag instead of one pickup each, a lone stack is still dropped as a pickup.
+	// ItemsToDrop mustn't be a view of the inventory contents, those change while the stacks are moved out.
+	void DropItems(TConstArrayView<UItemBase*> ItemsToDrop);
+	// Empties the whole inventory into one loot bag, for death drops
+	void DropAllItems();
+
+	// Uses up to Amount of an item in the player inventory, returns how many were used
+	int32 UseItem(UItemBase* ItemToUse, const int32 Amount = 1);
 
 protected:
 	//=========================================================================================================================
@@ -122,10 +138,21 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Character | Inventory")
 	UCpp_AC_Inventory* PlayerInventory;
 
+	UPROPERTY(VisibleAnywhere, Category = "Character | Inventory")
+	UCpp_AC_ItemEffects* ItemEffects;
+
+	// Spawned by multi item and death drops, the blueprint subclass gives it its mesh.
+	// A class whose mesh was cleared can't be seen or traced, its drops fall back to one pickup per stack.
+	UPROPERTY(EditDefaultsOnly, Category = "Character | Inventory")
+	TSubclassOf<ALootContainer> LootBagClass;
+
+	UPROPERTY(Transient)
+	UCpp_InteractionTimerSubsystem* InteractionTimers;
+
 	// Interaction Variables
 	float InteractionFrequency;	
 	float InteractionCheckDistance;
-	FTimerHandle TimerHandleInteraction;
+	FCpp_TimerWheelHandle InteractionTimerHandle;
 	FInteractionData InteractionData;
 	
 	// Timeline Variables used for camera aiming transition
@@ -151,12 +178,19 @@ protected:
 	// APawn interface	
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	// In front of the character, where drops are spawned
+	FTransform GetDropTransform() const;
+	// nullptr if LootBagClass has no mesh, the stacks have to be dropped as pickups then
+	ALootContainer* SpawnLootBag(const int32 NumStacks, const float TotalWeight);
+
 	void PerformInteractionCheck();
 	void FoundInteractable(AActor* NewInteractable);
 	void NoInteractableFound();
 	void BeginInteract();
 	void EndInteract();
 	void Interact();
+	// Pushed by the interaction timer for the current timed interaction
+	void OnInteractionProgress(const float Progress);
 
 	void ToggleMenu();
 	
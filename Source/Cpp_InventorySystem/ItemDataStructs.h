@@ -23,6 +23,10 @@ enum class EItemType : uint8 {
 	Other UMETA(DisplayName = "Other"),
 };
 
+// Number of values in the item enums, used to size per-type and per-quality lookup tables
+constexpr int32 NumItemQualities = static_cast<int32>(EItemQuality::Legendary) + 1;
+constexpr int32 NumItemTypes = static_cast<int32>(EItemType::Other) + 1;
+
 USTRUCT() // Item Statistics
 struct FItemStatistics {	
 	GENERATED_USTRUCT_BODY()
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/Cpp_CookItemCatalogCommandlet.h"
+#include "Data/Cpp_ItemCatalog.h"
+#include "Engine/DataTable.h"
+#include "Misc/Paths.h"
+
+UCpp_CookItemCatalogCommandlet::UCpp_CookItemCatalogCommandlet() {
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCpp_CookItemCatalogCommandlet::Main(const FString& Params) {
+	FString TablePath;
+	if (!FParse::Value(*Params, TEXT("Table="), TablePath)) {
+		UE_LOG(LogTemp, Error, TEXT("Missing -Table=<DataTable Path> argument!"));
+		return 1;
+	}
+
+	FString OutputPath = TEXT("Catalog/Items.icat");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	if (FPaths::IsRelative(OutputPath)) {
+		OutputPath = FPaths::Combine(FPaths::ProjectContentDir(), OutputPath);
+	}
+
+	const UDataTable* ItemTable = LoadObject<UDataTable>(nullptr, *TablePath);
+	if (!ItemTable || ItemTable->GetRowStruct() != FItemData::StaticStruct()) {
+		UE_LOG(LogTemp, Error, TEXT("%s is not a data table of FItemData rows!"), *TablePath);
+		return 1;
+	}
+
+	if (!FCpp_ItemCatalog::WriteCatalog(ItemTable, OutputPath)) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to write Item Catalog to %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Wrote %d items to Item Catalog %s"), ItemTable->GetRowMap().Num(), *OutputPath);
+	return 0;
+}
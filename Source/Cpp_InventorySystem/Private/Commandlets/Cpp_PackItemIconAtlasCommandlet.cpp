@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/Cpp_PackItemIconAtlasCommandlet.h"
+#include "Data/Cpp_ItemIconAtlas.h"
+#include "../ItemDataStructs.h"
+#include "Engine/DataTable.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#if WITH_EDITOR
+namespace {
+	// Pixels of edge copies around every icon
+	constexpr int32 IconPadding = 2;
+
+	bool SaveAsset(UObject* Asset) {
+		UPackage* Package = Asset->GetOutermost();
+		Package->MarkPackageDirty();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		return UPackage::SavePackage(Package, Asset, *Filename, SaveArgs);
+	}
+
+	UTexture2D* CreatePage(const FString& PackageName, const int32 PageSize, const TArray64<FColor>& Pixels) {
+		UPackage* Package = CreatePackage(*PackageName);
+		UTexture2D* Page = NewObject<UTexture2D>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+		Page->Source.Init(PageSize, PageSize, 1, 1, TSF_BGRA8, reinterpret_cast<const uint8*>(Pixels.GetData()));
+		Page->SRGB = true;
+		// Uncompressed and without mips, icons are drawn at (close to) their packed size
+		Page->CompressionSettings = TC_EditorIcon;
+		Page->MipGenSettings = TMGS_NoMipmaps;
+		Page->LODGroup = TEXTUREGROUP_UI;
+		Page->NeverStream = true;
+		Page->PostEditChange();
+		return Page;
+	}
+}
+#endif
+
+UCpp_PackItemIconAtlasCommandlet::UCpp_PackItemIconAtlasCommandlet() {
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCpp_PackItemIconAtlasCommandlet::Main(const FString& Params) {
+#if WITH_EDITOR
+	FString TablePath;
+	if (!FParse::Value(*Params, TEXT("Table="), TablePath)) {
+		UE_LOG(LogTemp, Error, TEXT("Missing -Table=<DataTable Path> argument!"));
+		return 1;
+	}
+
+	FString OutputPackage = TEXT("/Game/UI/DA_ItemIconAtlas");
+	FParse::Value(*Params, TEXT("Output="), OutputPackage);
+	int32 IconSize = 128;
+	FParse::Value(*Params, TEXT("IconSize="), IconSize);
+	int32 PageSize = 2048;
+	FParse::Value(*Params, TEXT("PageSize="), PageSize);
+
+	const int32 CellSize = IconSize + 2 * IconPadding;
+	if (IconSize <= 0 || PageSize < CellSize || !FPackageName::IsValidLongPackageName(OutputPackage)) {
+		UE_LOG(LogTemp, Error, TEXT("Invalid -IconSize / -PageSize / -Output arguments!"));
+		return 1;
+	}
+
+	const UDataTable* ItemTable = LoadObject<UDataTable>(nullptr, *TablePath);
+	if (!ItemTable || ItemTable->GetRowStruct() != FItemData::StaticStruct()) {
+		UE_LOG(LogTemp, Error, TEXT("%s is not a data table of FItemData rows!"), *TablePath);
+		return 1;
+	}
+
+	const int32 CellsPerRow = PageSize / CellSize;
+	const int32 CellsPerPage = CellsPerRow * CellsPerRow;
+
+	TArray<TObjectPtr<UTexture2D>> Pages;
+	TMap<FName, FItemIconAtlasEntry> Entries;
+	// Items sharing an icon share its cell
+	TMap<const UTexture2D*, FItemIconAtlasEntry> PackedIcons;
+
+	TArray64<FColor> PagePixels;
+	int32 NumCellsUsed = 0;
+	auto FlushPage = [&]() {
+		if (NumCellsUsed > 0) {
+			Pages.Add(CreatePage(FString::Printf(TEXT("%s_Page%d"), *OutputPackage, Pages.Num()), PageSize, PagePixels));
+			NumCellsUsed = 0;
+		}
+	};
+
+	for (const TPair<FName, uint8*>& Row : ItemTable->GetRowMap()) {
+		const FItemData* ItemData = reinterpret_cast<const FItemData*>(Row.Value);
+		UTexture2D* Icon = ItemData->ItemAssetData.Icon;
+		if (!Icon) {
+			continue;
+		}
+		if (const FItemIconAtlasEntry* Packed = PackedIcons.Find(Icon)) {
+			Entries.Add(ItemData->ID, *Packed);
+			continue;
+		}
+
+		FImage SourceImage;
+		if (!Icon->Source.IsValid() || !Icon->Source.GetMipImage(SourceImage, 0)) {
+			UE_LOG(LogTemp, Warning, TEXT("Icon %s of %s has no source data, skipped!"), *Icon->GetPathName(), *ItemData->ID.ToString());
+			continue;
+		}
+		FImage IconImage;
+		SourceImage.ResizeTo(IconImage, IconSize, IconSize, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+		const TArrayView64<FColor> IconPixels = IconImage.AsBGRA8();
+
+		if (NumCellsUsed == CellsPerPage) {
+			FlushPage();
+		}
+		if (NumCellsUsed == 0) {
+			PagePixels.Init(FColor::Transparent, static_cast<int64>(PageSize) * PageSize);
+		}
+
+		// Copy the icon into its cell, clamping the source coordinates fills the padding with the edge pixels
+		const int32 CellX = (NumCellsUsed % CellsPerRow) * CellSize;
+		const int32 CellY = (NumCellsUsed / CellsPerRow) * CellSize;
+		for (int32 Y = 0; Y < CellSize; ++Y) {
+			const int32 SourceY = FMath::Clamp(Y - IconPadding, 0, IconSize - 1);
+			for (int32 X = 0; X < CellSize; ++X) {
+				const int32 SourceX = FMath::Clamp(X - IconPadding, 0, IconSize - 1);
+				PagePixels[static_cast<int64>(CellY + Y) * PageSize + CellX + X] = IconPixels[static_cast<int64>(SourceY) * IconSize + SourceX];
+			}
+		}
+		++NumCellsUsed;
+
+		FItemIconAtlasEntry Entry;
+		Entry.Page = Pages.Num();
+		Entry.UVMin = FVector2D(CellX + IconPadding, CellY + IconPadding) / PageSize;
+		Entry.UVMax = FVector2D(CellX + IconPadding + IconSize, CellY + IconPadding + IconSize) / PageSize;
+		PackedIcons.Add(Icon, Entry);
+		Entries.Add(ItemData->ID, Entry);
+	}
+	FlushPage();
+
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex) {
+		if (!SaveAsset(Pages[PageIndex])) {
+			UE_LOG(LogTemp, Error, TEXT("Failed to save Icon Atlas page %d!"), PageIndex);
+			return 1;
+		}
+	}
+
+	UPackage* AtlasPackage = CreatePackage(*OutputPackage);
+	UCpp_ItemIconAtlas* Atlas = FindObject<UCpp_ItemIconAtlas>(AtlasPackage, *FPackageName::GetShortName(OutputPackage));
+	if (!Atlas) {
+		Atlas = NewObject<UCpp_ItemIconAtlas>(AtlasPackage, *FPackageName::GetShortName(OutputPackage), RF_Public | RF_Standalone);
+	}
+	const int32 NumPages = Pages.Num();
+	const int32 NumEntries = Entries.Num();
+	Atlas->SetPackedContents(IconSize, MoveTemp(Pages), MoveTemp(Entries));
+
+	if (!SaveAsset(Atlas)) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to save Icon Atlas %s"), *OutputPackage);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Packed %d icons for %d items into %d Icon Atlas pages, %s"), PackedIcons.Num(), NumEntries, NumPages, *OutputPackage);
+	return 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("The Icon Atlas can only be packed in the editor!"));
+	return 1;
+#endif
+}
@@ -3,6 +3,88 @@
 
 #include "Components/Cpp_AC_Inventory.h"
 #include "ItemBase.h"
+#include "../Cpp_InventorySystem.h"
+#include "Cpp_ItemPool.h"
+#include "Algo/StableSort.h"
+#include "HAL/IConsoleManager.h"
+
+// Should stay at 0 during UI refreshes, every hit is a full copy of an inventory's contents
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contents Copies"), STAT_InventoryContentsCopies, STATGROUP_Inventory);
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarValidateInventoryAggregates(
+	TEXT("Inventory.ValidateAggregates"),
+	false,
+	TEXT("Recomputes every inventory's weight and quantity totals after each operation and asserts they match the incremental ones."));
+#endif
+
+void FInventoryAggregates::AccountItem(const UItemBase* Item, const int32 QuantityDelta) {
+	AccountItem(Item->ItemType, Item->ItemQuality, ToFixedWeight(Item->ItemNumericData.Weight), QuantityDelta);
+}
+
+void FInventoryAggregates::AccountItem(const EItemType Type, const EItemQuality Quality, const int64 SingleWeight, const int32 QuantityDelta) {
+	const int64 WeightDelta = SingleWeight * QuantityDelta;
+	const int32 TypeIndex = static_cast<int32>(Type);
+	const int32 QualityIndex = static_cast<int32>(Quality);
+
+	TotalWeight += WeightDelta;
+	TotalQuantity += QuantityDelta;
+	WeightByType[TypeIndex] += WeightDelta;
+	QuantityByType[TypeIndex] += QuantityDelta;
+	WeightByQuality[QualityIndex] += WeightDelta;
+	QuantityByQuality[QualityIndex] += QuantityDelta;
+}
+
+bool FInventoryAggregates::operator==(const FInventoryAggregates& Other) const {
+	return TotalWeight == Other.TotalWeight
+		&& TotalQuantity == Other.TotalQuantity
+		&& FMemory::Memcmp(WeightByType, Other.WeightByType, sizeof(WeightByType)) == 0
+		&& FMemory::Memcmp(QuantityByType, Other.QuantityByType, sizeof(QuantityByType)) == 0
+		&& FMemory::Memcmp(WeightByQuality, Other.WeightByQuality, sizeof(WeightByQuality)) == 0
+		&& FMemory::Memcmp(QuantityByQuality, Other.QuantityByQuality, sizeof(QuantityByQuality)) == 0;
+}
+
+const FText& FItemAddResult::GetResultMessage() const {
+	if (!bResultMessageFormatted) {
+		// Patterns are compiled once, formatting only substitutes the arguments
+		static const FTextFormat AddedSingleFormat(FText::FromString("Successfully added {0} to the inventory!"));
+		static const FTextFormat AddedStackFormat(FText::FromString("Successfully added {0} {1} to the inventory!"));
+		static const FTextFormat AddedPartiallyFormat(FText::FromString("Could not add all {0} to the inventory. Added {1} {0} instead!"));
+		static const FTextFormat NoWeightFormat(FText::FromString("Could not add {0} to the inventory. Item Has No Weight!"));
+		static const FTextFormat OverWeightLimitFormat(FText::FromString("Could not add {0} to the inventory. Item overflows weight limit!"));
+		static const FTextFormat NoFreeSlotFormat(FText::FromString("Could not add {0} to the inventory. No Free Inventory Slot!"));
+		static const FTextFormat NoRoomOrInvalidFormat(FText::FromString("Could not add {0} to the inventory. No Remaining Slots / Invalid Item!"));
+
+		switch (Reason) {
+			case EItemAddReason::IAR_AddedSingle:
+				CachedResultMessage = FText::Format(AddedSingleFormat, ItemName);
+				break;
+			case EItemAddReason::IAR_AddedStack:
+				CachedResultMessage = FText::Format(AddedStackFormat, ItemName, ActualAmountAdded);
+				break;
+			case EItemAddReason::IAR_AddedPartially:
+				CachedResultMessage = FText::Format(AddedPartiallyFormat, ItemName, ActualAmountAdded);
+				break;
+			case EItemAddReason::IAR_NoWeight:
+				CachedResultMessage = FText::Format(NoWeightFormat, ItemName);
+				break;
+			case EItemAddReason::IAR_OverWeightLimit:
+				CachedResultMessage = FText::Format(OverWeightLimitFormat, ItemName);
+				break;
+			case EItemAddReason::IAR_NoFreeSlot:
+				CachedResultMessage = FText::Format(NoFreeSlotFormat, ItemName);
+				break;
+			case EItemAddReason::IAR_NoRoomOrInvalid:
+				CachedResultMessage = FText::Format(NoRoomOrInvalidFormat, ItemName);
+				break;
+			case EItemAddReason::IAR_NoOwner:
+				CachedResultMessage = FText::FromString("Could not add item to the inventory. No Owner Found!");
+				break;
+		}
+		bResultMessageFormatted = true;
+	}
+	return CachedResultMessage;
+}
 
 // Constructor for the class.
 UCpp_AC_Inventory::UCpp_AC_Inventory() {
@@ -27,79 +109,95 @@ void UCpp_AC_Inventory::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 
 
 
+TArray<UItemBase*> UCpp_AC_Inventory::GetInventoryContents() const {
+	INC_DWORD_STAT(STAT_InventoryContentsCopies);
+	TArray<UItemBase*> Contents;
+	Contents.Reserve(NumItems);
+	for (UItemBase* InventoryItem : InventoryContents) {
+		if (InventoryItem) {
+			Contents.Add(InventoryItem);
+		}
+	}
+	return Contents;
+}
+
 UItemBase* UCpp_AC_Inventory::FindMatchingItem(UItemBase* InItem) const {
-	if(InItem && InventoryContents.Contains(InItem)) {
+	// Every stack in the contents is owned by this inventory and released stacks are unowned, so no scan is needed
+	if(InItem && InItem->OwningInventory == this) {
 		return InItem;		
 	}
 	return nullptr;
 }
 
 UItemBase* UCpp_AC_Inventory::FindNextItemByID(UItemBase* InItem) const {
-	// Only works as overloaded operator is implemented in UItemBase for the == operator.
-	// Element Type is used to get the type of the array elements.
+	// Looked up in the ID index instead of scanning the whole inventory
 	if(InItem) {
-		const TArray<TObjectPtr<UItemBase>>::ElementType* Result = InventoryContents.FindByKey(InItem);
-		if (Result)
-			return *Result;
+		if (const TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(InItem->ID)) {
+			return (*Stacks)[0];
+		}
 	}
 	return nullptr;
 }
 
 UItemBase* UCpp_AC_Inventory::FindNextPartialStack(UItemBase* InItem) const {
-	/*Summary Of If Statement :
-	Result is a pointer to the element type of the array UItemBase.
-	FindByPredicate is used to find the first element that satisfies the predicate.
-	FindByPredicate returns a pointer to the element type of the array UItemBase.
-	Lambda function is used to check if the ID of both are the same AND
-	if the item is not a full stack which means it can be added to
-	[&InItem] is the capture list for the lambda function which
-	means it can access the InItem variable to compare it with the InventoryItem.
-	If the result is not null, return the result */
-	if(const TArray<TObjectPtr<UItemBase>>::ElementType* Result = 
-		InventoryContents.FindByPredicate([&InItem](const UItemBase* InventoryItem) {
-				return InventoryItem->ID == InItem->ID && !InventoryItem->IsFullItemStack();
+	// Only the stacks sharing the ID of InItem are checked, the ID index holds them
+	if(const TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(InItem->ID)) {
+		for (UItemBase* Stack : *Stacks) {
+			if (!Stack->IsFullItemStack()) {
+				return Stack;
 			}
-		)) {
-		return *Result;
+		}
 	}
 	return nullptr;
 }
 
 void UCpp_AC_Inventory::RemoveSingleInstanceOfItem(UItemBase* ItemToRemove) {
-	InventoryContents.RemoveSingle(ItemToRemove);
+	if (ItemToRemove && ItemToRemove->OwningInventory == this) {
+		DetachItem(ItemToRemove);
+		// An emptied stack is of no use to anyone, recycle it for the next split or pickup copy
+		if (ItemToRemove->Quantity == 0) {
+			FCpp_ItemPool::Get().Release(ItemToRemove);
+		}
+	}
 	// Calls The Broadcast Function To Tell Other Classes That The Inventory Has Been Updated.
-	OnInventoryUpdated.Broadcast();
+	NotifyInventoryUpdated();
 }
 
 int32 UCpp_AC_Inventory::RemoveAmountOfItem(UItemBase* InItem, const int32 AmountToRemove) {
 	const int32 ActualAmountToRemove = FMath::Min(AmountToRemove, InItem->Quantity);
+	// The total weight of the inventory is reduced through UpdateItemQuantity
 	InItem->SetQuantity(InItem->Quantity - ActualAmountToRemove);
 
-	// Reduces the total weight of the inventory by the amount of items removed and their weight.
-	InventoryTotalWeight -= ActualAmountToRemove * InItem->GetItemSingleWeight();
-
 	// Calls The Broadcast Function To Tell Other Classes That The Inventory Has Been Updated.
-	OnInventoryUpdated.Broadcast();
+	NotifyInventoryUpdated();
 	return ActualAmountToRemove;
 }
 
 void UCpp_AC_Inventory::SplitExistingStack(UItemBase* InItem, const int32 AmountToSplit) {
-	if(!(InventoryContents.Num() + 1 > InventorySlotsCapacity)) {
+	// Splitting off the whole stack would empty (and recycle) InItem before the copy is made from it
+	if(AmountToSplit <= 0 || AmountToSplit >= InItem->Quantity) {
+		return;
+	}
+	if(!(NumItems + 1 > InventorySlotsCapacity)) {
+		FInventoryUpdateBatch UpdateBatch(this);
 		RemoveAmountOfItem(InItem, AmountToSplit);
 		AddNewItem(InItem, AmountToSplit);
 	}
 }
 
-int32 UCpp_AC_Inventory::CalculateWeightAddAmount(UItemBase* InItem, int32 AddAmount) {
+int32 UCpp_AC_Inventory::CalculateWeightAddAmount(const UItemBase* InItem, int32 AddAmount) const {
 	// Calculate the amount of weight that can be added to the inventory.
-	// FloorToInt is used to round down the result of the division
-	// eg. (90 - 55) / 10 = 3.5 -> FloorToInt(3.5) = 3
-	const int32 WeightMaxAddAmount = FMath::FloorToInt((GetWeightCapacity() - InventoryTotalWeight) 
-													   / InItem->GetItemSingleWeight());
+	// Integer division on the fixed-point weights rounds down the result
+	// eg. (90 - 55) / 10 = 3.5 -> 3
+	const int64 SingleWeight = FInventoryAggregates::ToFixedWeight(InItem->GetItemSingleWeight());
+	if(SingleWeight <= 0) {
+		return 0;
+	}
+	const int64 WeightMaxAddAmount = FMath::Max<int64>(GetFixedWeightCapacity() - Aggregates.TotalWeight, 0) / SingleWeight;
 	if(WeightMaxAddAmount >= AddAmount) {
 		return AddAmount;
 	}
-	return WeightMaxAddAmount;
+	return static_cast<int32>(WeightMaxAddAmount);
 }
 
 int32 UCpp_AC_Inventory::CalculateNumberForFullStack(UItemBase* StackableItem, int32 InitialAddAmount) {
@@ -112,31 +210,23 @@ FItemAddResult UCpp_AC_Inventory::HandleNonStackableItems(UItemBase* InItem) {
 	// Check if input item has valid weight
 	if(FMath::IsNearlyZero(InItem->GetItemSingleWeight()) || InItem->GetItemSingleWeight() < 0) {
 		// return added no items
-		return FItemAddResult::AddedNone(FText::Format(
-				FText::FromString("Could not add {0} to the inventory. Item Has No Weight!"), 
-					InItem->ItemTextData.ItemName));
+		return FItemAddResult::AddedNone(EItemAddReason::IAR_NoWeight, InItem->ItemTextData.ItemName);
 	}
 
 	// Will item weight exceed inventory weight capacity?
-	if(InventoryTotalWeight + InItem->GetItemSingleWeight() > GetWeightCapacity()) {
+	if(!CanCarryAdditionalWeight(InItem->GetItemSingleWeight())) {
 		// return added no items
-		return FItemAddResult::AddedNone(FText::Format(
-			FText::FromString("Could not add {0} to the inventory. Item overflows weight limit!"),
-			InItem->ItemTextData.ItemName));
+		return FItemAddResult::AddedNone(EItemAddReason::IAR_OverWeightLimit, InItem->ItemTextData.ItemName);
 	}
 
 	// Will inventory exceed capacity?
-	if(InventoryContents.Num() + 1 > InventorySlotsCapacity) {
-		return FItemAddResult::AddedNone(FText::Format(
-			FText::FromString("Could not add {0} to the inventory. No Free Inventory Slot!"),
-			InItem->ItemTextData.ItemName));
+	if(NumItems + 1 > InventorySlotsCapacity) {
+		return FItemAddResult::AddedNone(EItemAddReason::IAR_NoFreeSlot, InItem->ItemTextData.ItemName);
 	}
 	
 	AddNewItem(InItem, 1);
 	// return added all items
-	return FItemAddResult::AddedAll(1, FText::Format(
-		FText::FromString("Successfully added {0} to the inventory!"),
-		InItem->ItemTextData.ItemName));
+	return FItemAddResult::AddedAll(1, EItemAddReason::IAR_AddedSingle, InItem->ItemTextData.ItemName);
 }
 
 int32 UCpp_AC_Inventory::HandleStackableItems(UItemBase* InItem, int32 AddAmount) {
@@ -160,9 +250,8 @@ int32 UCpp_AC_Inventory::HandleStackableItems(UItemBase* InItem, int32 AddAmount
 		
 		// As long as the remaining amount to distribute does not exceed the weight limit, add the items to the stack.
 		if (WeightLimitAddAmount > 0) {
-			// Add the items to the existing stack and update the total weight of the inventory.
+			// Add the items to the existing stack, the total weight of the inventory follows through UpdateItemQuantity.
 			ExistingItemStack->SetQuantity(ExistingItemStack->Quantity + WeightLimitAddAmount);
-			InventoryTotalWeight += WeightLimitAddAmount * ExistingItemStack->GetItemSingleWeight();
 
 			// Update the amount of items that still need to be distributed.
 			AmountToDistribute -= WeightLimitAddAmount;
@@ -170,8 +259,8 @@ int32 UCpp_AC_Inventory::HandleStackableItems(UItemBase* InItem, int32 AddAmount
 			InItem->SetQuantity(AmountToDistribute);
 			
 			// if max weight capacity is exceeded after adding another item, return the remaining amount to distribute
-			if (InventoryTotalWeight + ExistingItemStack->GetItemSingleWeight() > InventoryWeightCapacity) {
-				OnInventoryUpdated.Broadcast();
+			if (!CanCarryAdditionalWeight(ExistingItemStack->GetItemSingleWeight())) {
+				NotifyInventoryUpdated();
 				return AddAmount - AmountToDistribute;
 			}
 		}
@@ -179,7 +268,7 @@ int32 UCpp_AC_Inventory::HandleStackableItems(UItemBase* InItem, int32 AddAmount
 			if (AmountToDistribute != AddAmount) {
 				// will reach this only if distributing an item to multiple stacks
 				// and the weight limit is reached before the amount to distribute is 0
-				OnInventoryUpdated.Broadcast();
+				NotifyInventoryUpdated();
 				return AddAmount - AmountToDistribute;
 			}
 			// If the weight limit is reached before adding any items to the stack
@@ -187,7 +276,7 @@ int32 UCpp_AC_Inventory::HandleStackableItems(UItemBase* InItem, int32 AddAmount
 		}
 		if (AmountToDistribute <= 0) {
 			// All of the items have been distributed to the existing stacks.
-			OnInventoryUpdated.Broadcast();
+			NotifyInventoryUpdated();
 			return AddAmount;	
 		}
 
@@ -196,7 +285,7 @@ int32 UCpp_AC_Inventory::HandleStackableItems(UItemBase* InItem, int32 AddAmount
 	}
 
 	// No existing stack found, check if there is space in the inventory to add a new stack.
-	if (InventoryContents.Num() + 1 <= InventorySlotsCapacity) {
+	if (NumItems + 1 <= InventorySlotsCapacity) {
 		// Attempt to add the remaining items to a new stack.
 		const int32 WeightLimitAddAmount = CalculateWeightAddAmount(InItem, AmountToDistribute);
 
@@ -234,22 +323,16 @@ FItemAddResult UCpp_AC_Inventory::HandleAddItem(UItemBase* InItem) {
 		const int32 StackableAmountAdded = HandleStackableItems(InItem, InitialRequestedAddAmount);
 
 		if(StackableAmountAdded == InitialRequestedAddAmount) {
-			return FItemAddResult::AddedAll(InitialRequestedAddAmount, FText::Format(
-				FText::FromString("Successfully added {0} {1} to the inventory!"),
-				InItem->ItemTextData.ItemName, StackableAmountAdded));
+			return FItemAddResult::AddedAll(InitialRequestedAddAmount, EItemAddReason::IAR_AddedStack, InItem->ItemTextData.ItemName);
 		}
 		else if(StackableAmountAdded < InitialRequestedAddAmount && StackableAmountAdded > 0) {
-			return FItemAddResult::AddedSome(StackableAmountAdded, FText::Format(
-				FText::FromString("Could not add all {0} to the inventory. Added {1} {0} instead!"),
-				InItem->ItemTextData.ItemName, StackableAmountAdded));
+			return FItemAddResult::AddedSome(StackableAmountAdded, InItem->ItemTextData.ItemName);
 		}
 		else {
-			return FItemAddResult::AddedNone(FText::Format(
-				FText::FromString("Could not add {0} to the inventory. No Remaining Slots / Invalid Item!"),
-				InItem->ItemTextData.ItemName));
+			return FItemAddResult::AddedNone(EItemAddReason::IAR_NoRoomOrInvalid, InItem->ItemTextData.ItemName);
 		}
 	}
-	return FItemAddResult::AddedNone(FText::FromString("Could not add item to the inventory. No Owner Found!"));
+	return FItemAddResult::AddedNone(EItemAddReason::IAR_NoOwner, FText::GetEmpty());
 }
 
 void UCpp_AC_Inventory::AddNewItem(UItemBase* InItem, const int32 AddAmount) {
@@ -263,11 +346,531 @@ void UCpp_AC_Inventory::AddNewItem(UItemBase* InItem, const int32 AddAmount) {
 		// used for splitting or dragging items from another inventory
 		NewItem = InItem->CreateItemCopy();
 	}
-	NewItem->OwningInventory = this;
+	// Account for the stack as it is, then SetQuantity reports the difference through UpdateItemQuantity
+	AttachItem(NewItem);
 	NewItem->SetQuantity(AddAmount);
-	InventoryContents.Add(NewItem);
-	InventoryTotalWeight += NewItem->GetItemStackWeight();	
 	// Call the OnInventoryUpdated event to notify other classes that the inventory has been updated.
+	NotifyInventoryUpdated();
+}
+
+int32 UCpp_AC_Inventory::AddAmountOfItem(const FItemData& ItemData, const int32 Amount) {
+	UItemBase* NewItem = FCpp_ItemPool::Get().Acquire();
+	NewItem->InitializeFromItemData(ItemData);
+	NewItem->Quantity = Amount;
+
+	const int32 AcceptedAmount = CalculateAcceptableAmount(NewItem, Amount);
+	if (AcceptedAmount <= 0) {
+		NewItem->Quantity = 0;
+		FCpp_ItemPool::Get().Release(NewItem);
+		return 0;
+	}
+
+	// NewItem becomes the last new stack, or goes back to the pool if everything merged into existing stacks
+	ReceiveAmount(NewItem, AcceptedAmount, NewItem);
+	NotifyInventoryUpdated();
+	return AcceptedAmount;
+}
+
+TConstArrayView<UItemBase*> UCpp_AC_Inventory::QueryItems(const FInventoryQuery& Query) const {
+	return QueryIndex.Run(Query, InventoryContents);
+}
+
+void UCpp_AC_Inventory::CompactAndSort(const EInventorySortKey SortKey) {
+	// Merge pass, per ID the partial stacks at the back are poured into the partial stacks at the front
+	for (TPair<FName, TArray<UItemBase*, TInlineAllocator<2>>>& IDStacks : StacksByID) {
+		TArray<UItemBase*, TInlineAllocator<2>>& Stacks = IDStacks.Value;
+		if (Stacks.Num() < 2 || !Stacks[0]->ItemNumericData.bIsStackable) {
+			continue;
+		}
+
+		int32 TargetIndex = 0;
+		int32 SourceIndex = Stacks.Num() - 1;
+		while (TargetIndex < SourceIndex) {
+			UItemBase* TargetStack = Stacks[TargetIndex];
+			UItemBase* SourceStack = Stacks[SourceIndex];
+			if (TargetStack->Quantity >= TargetStack->ItemNumericData.MaxStackSize) {
+				++TargetIndex;
+				continue;
+			}
+			if (SourceStack->Quantity >= SourceStack->ItemNumericData.MaxStackSize) {
+				--SourceIndex;
+				continue;
+			}
+
+			// Same item on both sides, so the totals don't change and the quantities can be moved directly
+			const int32 MoveAmount = FMath::Min(TargetStack->ItemNumericData.MaxStackSize - TargetStack->Quantity, SourceStack->Quantity);
+			TargetStack->Quantity += MoveAmount;
+			SourceStack->Quantity -= MoveAmount;
+			if (SourceStack->Quantity <= 0) {
+				QueryIndex.RemoveName(SourceStack);
+				SourceStack->OwningInventory = nullptr;
+				FCpp_ItemPool::Get().Release(SourceStack);
+				--SourceIndex;
+			}
+		}
+
+		Stacks.RemoveAll([](const UItemBase* Stack) {
+			return Stack->Quantity <= 0;
+		});
+	}
+
+	// Emptied stacks and empty slots are squeezed out together, the sort hands out new slots anyway
+	InventoryContents.RemoveAll([this](const UItemBase* InventoryItem) {
+		return !InventoryItem || InventoryItem->OwningInventory != this;
+	});
+	FreeSlots.Reset();
+	NumItems = InventoryContents.Num();
+	QueryIndex.MarkSlotsDirty();
+
+	// Algo::StableSort merges in place, no temporary buffer is allocated
+	switch (SortKey) {
+		case EInventorySortKey::Type:
+			Algo::StableSort(InventoryContents, [](const UItemBase* A, const UItemBase* B) {
+				return A->ItemType < B->ItemType;
+			});
+			break;
+		case EInventorySortKey::Quality:
+			Algo::StableSort(InventoryContents, [](const UItemBase* A, const UItemBase* B) {
+				return A->ItemQuality > B->ItemQuality;
+			});
+			break;
+		case EInventorySortKey::Weight:
+			Algo::StableSort(InventoryContents, [](const UItemBase* A, const UItemBase* B) {
+				return A->GetItemStackWeight() > B->GetItemStackWeight();
+			});
+			break;
+		case EInventorySortKey::SellValue:
+			Algo::StableSort(InventoryContents, [](const UItemBase* A, const UItemBase* B) {
+				return A->ItemStatistics.SellValue * A->Quantity > B->ItemStatistics.SellValue * B->Quantity;
+			});
+			break;
+	}
+	for (int32 Slot = 0; Slot < InventoryContents.Num(); ++Slot) {
+		InventoryContents[Slot]->SlotIndex = Slot;
+	}
+
+	PendingChangeSet.MarkLayoutChanged();
+	NotifyInventoryUpdated();
+}
+
+bool UCpp_AC_Inventory::MoveItemToSlot(UItemBase* InItem, const int32 TargetSlot) {
+	if (!InItem || InItem->OwningInventory != this) {
+		return false;
+	}
+	return SwapSlots(InItem->SlotIndex, TargetSlot);
+}
+
+bool UCpp_AC_Inventory::SwapSlots(const int32 SlotA, const int32 SlotB) {
+	// Stacks left past a lowered capacity can still be moved back in
+	const int32 NumSlots = FMath::Max(InventorySlotsCapacity, InventoryContents.Num());
+	if (SlotA < 0 || SlotB < 0 || SlotA >= NumSlots || SlotB >= NumSlots) {
+		return false;
+	}
+
+	UItemBase* ItemA = GetItemInSlot(SlotA);
+	UItemBase* ItemB = GetItemInSlot(SlotB);
+	if (SlotA == SlotB || (!ItemA && !ItemB)) {
+		return true;
+	}
+
+	EnsureSlot(FMath::Max(SlotA, SlotB));
+	PlaceInSlot(ItemB, SlotA);
+	PlaceInSlot(ItemA, SlotB);
+	NotifyInventoryUpdated();
+	return true;
+}
+
+void UCpp_AC_Inventory::AttachItem(UItemBase* InItem) {
+	const int32 Slot = AcquireSlot();
+	InventoryContents[Slot] = InItem;
+	InItem->SlotIndex = Slot;
+	++NumItems;
+	PendingChangeSet.MarkSlotChanged(Slot);
+	QueryIndex.AddItem(InItem, Slot);
+	InItem->OwningInventory = this;
+	Aggregates.AccountItem(InItem, InItem->Quantity);
+	StacksByID.FindOrAdd(InItem->ID).Add(InItem);
+}
+
+void UCpp_AC_Inventory::DetachItem(UItemBase* InItem) {
+	// The slot becomes a hole instead of every later stack shifting down
+	const int32 Slot = InItem->SlotIndex;
+	if (InventoryContents.IsValidIndex(Slot) && InventoryContents[Slot] == InItem) {
+		PlaceInSlot(nullptr, Slot);
+		--NumItems;
+	}
+	QueryIndex.RemoveName(InItem);
+	// Whatever is left in the stack no longer counts towards this inventory
+	Aggregates.AccountItem(InItem, -InItem->Quantity);
+	if (TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(InItem->ID)) {
+		Stacks->RemoveSingleSwap(InItem);
+		if (Stacks->IsEmpty()) {
+			StacksByID.Remove(InItem->ID);
+		}
+	}
+	InItem->OwningInventory = nullptr;
+	InItem->SlotIndex = INDEX_NONE;
+}
+
+int32 UCpp_AC_Inventory::AcquireSlot() {
+	while (!FreeSlots.IsEmpty()) {
+		const int32 Slot = FreeSlots.Pop(false);
+		// Stale entry, a stack was moved into the hole since it was freed
+		if (InventoryContents.IsValidIndex(Slot) && !InventoryContents[Slot]) {
+			return Slot;
+		}
+	}
+	return InventoryContents.Add(nullptr);
+}
+
+void UCpp_AC_Inventory::EnsureSlot(const int32 Slot) {
+	while (InventoryContents.Num() <= Slot) {
+		FreeSlots.Add(InventoryContents.Add(nullptr));
+	}
+}
+
+void UCpp_AC_Inventory::PlaceInSlot(UItemBase* InItem, const int32 Slot) {
+	InventoryContents[Slot] = InItem;
+	PendingChangeSet.MarkSlotChanged(Slot);
+	if (InItem) {
+		InItem->SlotIndex = Slot;
+		QueryIndex.SetSlot(InItem, Slot);
+		return;
+	}
+
+	QueryIndex.ClearSlot(Slot);
+	// Stale entries pile up as stacks are moved into holes, past twice the slot count the list is rebuilt from the holes
+	if (FreeSlots.Num() >= 2 * InventoryContents.Num()) {
+		FreeSlots.Reset();
+		for (int32 Index = InventoryContents.Num() - 1; Index >= 0; --Index) {
+			if (!InventoryContents[Index]) {
+				FreeSlots.Add(Index);
+			}
+		}
+	}
+	else {
+		FreeSlots.Add(Slot);
+	}
+}
+
+int32 UCpp_AC_Inventory::CalculateAcceptableAmount(const UItemBase* InItem, const int32 RequestedAmount) const {
+	if (!InItem || RequestedAmount <= 0) {
+		return 0;
+	}
+
+	const bool bIsStackable = InItem->ItemNumericData.bIsStackable;
+	const int64 AmountPerSlot = bIsStackable ? FMath::Max(InItem->ItemNumericData.MaxStackSize, 1) : 1;
+
+	// Room left in the partial stacks of the same item plus whatever fits in the free slots
+	int64 Room = FMath::Max(InventorySlotsCapacity - NumItems, 0) * AmountPerSlot;
+	if (bIsStackable) {
+		if (const TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(InItem->ID)) {
+			for (const UItemBase* Stack : *Stacks) {
+				Room += FMath::Max(Stack->ItemNumericData.MaxStackSize - Stack->Quantity, 0);
+			}
+		}
+	}
+
+	const int32 SlotLimitAmount = static_cast<int32>(FMath::Min<int64>(Room, RequestedAmount));
+	return CalculateWeightAddAmount(InItem, SlotLimitAmount);
+}
+
+int32 UCpp_AC_Inventory::TransferItem(UItemBase* InItem, UCpp_AC_Inventory* Destination, const int32 AmountToTransfer) {
+	if (!InItem || !Destination || Destination == this || InItem->OwningInventory != this) {
+		return 0;
+	}
+
+	// Everything is checked up front so the move either happens as calculated or not at all
+	const int32 AcceptedAmount = Destination->CalculateAcceptableAmount(InItem, FMath::Min(AmountToTransfer, InItem->Quantity));
+	if (AcceptedAmount <= 0) {
+		return 0;
+	}
+
+	FInventoryUpdateBatch SourceBatch(this);
+	FInventoryUpdateBatch DestinationBatch(Destination);
+
+	TransferAcceptedAmount(InItem, Destination, AcceptedAmount);
+	NotifyInventoryUpdated();
+	Destination->NotifyInventoryUpdated();
+	return AcceptedAmount;
+}
+
+int32 UCpp_AC_Inventory::TransferAll(UCpp_AC_Inventory* Destination) {
+	if (!Destination || Destination == this) {
+		return 0;
+	}
+
+	FInventoryUpdateBatch SourceBatch(this);
+	FInventoryUpdateBatch DestinationBatch(Destination);
+
+	int32 TotalTransferred = 0;
+	// Emptied stacks leave holes behind, nothing shifts while the slots are walked
+	for (int32 Slot = 0; Slot < InventoryContents.Num(); ++Slot) {
+		UItemBase* InventoryItem = InventoryContents[Slot];
+		if (!InventoryItem) {
+			continue;
+		}
+		const int32 AcceptedAmount = Destination->CalculateAcceptableAmount(InventoryItem, InventoryItem->Quantity);
+		if (AcceptedAmount > 0) {
+			TransferAcceptedAmount(InventoryItem, Destination, AcceptedAmount);
+			TotalTransferred += AcceptedAmount;
+		}
+	}
+
+	if (TotalTransferred > 0) {
+		NotifyInventoryUpdated();
+		Destination->NotifyInventoryUpdated();
+	}
+	return TotalTransferred;
+}
+
+void UCpp_AC_Inventory::TransferAcceptedAmount(UItemBase* InItem, UCpp_AC_Inventory* Destination, const int32 AmountToTransfer) {
+	if (AmountToTransfer >= InItem->Quantity) {
+		// The whole stack leaves, the item object itself can become the destination's new stack
+		DetachItem(InItem);
+		Destination->ReceiveAmount(InItem, AmountToTransfer, InItem);
+	}
+	else {
+		Destination->ReceiveAmount(InItem, AmountToTransfer, nullptr);
+		InItem->SetQuantity(InItem->Quantity - AmountToTransfer);
+	}
+}
+
+void UCpp_AC_Inventory::ReceiveAmount(UItemBase* Template, const int32 Amount, UItemBase* ReusableItem) {
+	int32 AmountToDistribute = Amount;
+
+	// Fill the partial stacks first
+	if (Template->ItemNumericData.bIsStackable) {
+		if (TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(Template->ID)) {
+			for (UItemBase* Stack : *Stacks) {
+				const int32 AddAmount = CalculateNumberForFullStack(Stack, AmountToDistribute);
+				if (AddAmount > 0) {
+					Stack->SetQuantity(Stack->Quantity + AddAmount);
+					AmountToDistribute -= AddAmount;
+				}
+				if (AmountToDistribute <= 0) {
+					break;
+				}
+			}
+		}
+	}
+
+	// Then open as many new stacks as the rest needs, CalculateAcceptableAmount already made sure the slots are free
+	const int32 AmountPerSlot = Template->ItemNumericData.bIsStackable ? FMath::Max(Template->ItemNumericData.MaxStackSize, 1) : 1;
+	while (AmountToDistribute > 0) {
+		const int32 StackAmount = FMath::Min(AmountToDistribute, AmountPerSlot);
+		UItemBase* NewStack = nullptr;
+		if (ReusableItem && StackAmount == AmountToDistribute) {
+			NewStack = ReusableItem;
+			ReusableItem = nullptr;
+		}
+		else {
+			NewStack = Template->CreateItemCopy();
+		}
+		// Unowned at this point, so the quantity is set directly and accounted for by AttachItem
+		NewStack->Quantity = StackAmount;
+		NewStack->ResetItemFlags();
+		AttachItem(NewStack);
+		AmountToDistribute -= StackAmount;
+	}
+
+	// Everything was merged into existing stacks, the item that was offered is empty now
+	if (ReusableItem) {
+		ReusableItem->Quantity = 0;
+		FCpp_ItemPool::Get().Release(ReusableItem);
+	}
+}
+
+void UCpp_AC_Inventory::ExecuteCommands(FInventoryCommandQueue& Queue) {
+	Queue.ResetResults();
+	for (const FInventoryCommand& Command : Queue.Commands) {
+		if (!Command.ItemData || Command.Amount <= 0) {
+			continue;
+		}
+		switch (Command.Type) {
+			case EInventoryCommandType::Add:
+				ExecuteAddCommand(Queue, *Command.ItemData, Command.Amount);
+				break;
+			case EInventoryCommandType::Remove:
+				ExecuteRemoveCommand(Queue, *Command.ItemData, Command.Amount);
+				break;
+		}
+	}
+}
+
+void UCpp_AC_Inventory::ExecuteAddCommand(FInventoryCommandQueue& Queue, const FItemData& ItemData, const int32 Amount) {
+	const bool bIsStackable = ItemData.ItemNumericData.MaxStackSize > 1;
+	const int32 AmountPerSlot = bIsStackable ? ItemData.ItemNumericData.MaxStackSize : 1;
+	const int64 SingleWeight = FInventoryAggregates::ToFixedWeight(ItemData.ItemNumericData.Weight);
+	if (SingleWeight <= 0) {
+		Queue.AmountRejected += Amount;
+		return;
+	}
+
+	// Same checks as CalculateAcceptableAmount, with the stacks still pending from earlier commands counted as taken
+	const int64 WeightLimitAmount = FMath::Max<int64>(GetFixedWeightCapacity() - Aggregates.TotalWeight - Queue.PendingWeight, 0) / SingleWeight;
+	int32 AmountToDistribute = static_cast<int32>(FMath::Min<int64>(Amount, WeightLimitAmount));
+	int32 AmountAdded = 0;
+
+	// Quantities of stacks already in the inventory can be changed here, nothing outside this inventory sees them until the broadcast
+	if (bIsStackable) {
+		if (TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(ItemData.ID)) {
+			for (UItemBase* Stack : *Stacks) {
+				if (AmountToDistribute <= 0) {
+					break;
+				}
+				const int32 AddAmount = FMath::Min(Stack->ItemNumericData.MaxStackSize - Stack->Quantity, AmountToDistribute);
+				if (AddAmount > 0) {
+					Stack->Quantity += AddAmount;
+					Aggregates.AccountItem(Stack, AddAmount);
+					PendingChangeSet.MarkItemChanged(Stack);
+					AmountToDistribute -= AddAmount;
+					AmountAdded += AddAmount;
+				}
+			}
+		}
+	}
+
+	// The rest goes into new stacks, merged with what earlier commands left pending for the same item
+	if (AmountToDistribute > 0) {
+		FInventoryCommandQueue::FPendingStacks* Pending = Queue.PendingStacks.FindByPredicate([&ItemData](const FInventoryCommandQueue::FPendingStacks& Entry) {
+			return Entry.ItemData->ID == ItemData.ID;
+		});
+		if (!Pending) {
+			Pending = &Queue.PendingStacks.Add_GetRef({&ItemData, 0, 0});
+		}
+
+		const int32 NumFreeSlots = FMath::Max(InventorySlotsCapacity - NumItems - Queue.PendingSlots, 0);
+		const int32 RoomInPending = Pending->NumSlots * AmountPerSlot - Pending->Amount;
+		const int32 NewStacksAmount = static_cast<int32>(FMath::Min<int64>(AmountToDistribute, RoomInPending + static_cast<int64>(NumFreeSlots) * AmountPerSlot));
+
+		Pending->Amount += NewStacksAmount;
+		const int32 NumSlots = FMath::DivideAndRoundUp(Pending->Amount, AmountPerSlot);
+		Queue.PendingSlots += NumSlots - Pending->NumSlots;
+		Pending->NumSlots = NumSlots;
+		Queue.PendingWeight += SingleWeight * NewStacksAmount;
+		AmountAdded += NewStacksAmount;
+	}
+
+	Queue.AmountAdded += AmountAdded;
+	Queue.AmountRejected += Amount - AmountAdded;
+}
+
+void UCpp_AC_Inventory::ExecuteRemoveCommand(FInventoryCommandQueue& Queue, const FItemData& ItemData, const int32 Amount) {
+	int32 AmountToRemove = Amount;
+
+	// Taken from what earlier commands in the queue added first, those stacks don't exist yet
+	if (FInventoryCommandQueue::FPendingStacks* Pending = Queue.PendingStacks.FindByPredicate([&ItemData](const FInventoryCommandQueue::FPendingStacks& Entry) {
+		return Entry.ItemData->ID == ItemData.ID;
+	})) {
+		const int32 AmountPerSlot = ItemData.ItemNumericData.MaxStackSize > 1 ? ItemData.ItemNumericData.MaxStackSize : 1;
+		const int32 RemoveAmount = FMath::Min(Pending->Amount, AmountToRemove);
+		Pending->Amount -= RemoveAmount;
+		const int32 NumSlots = FMath::DivideAndRoundUp(Pending->Amount, AmountPerSlot);
+		Queue.PendingSlots += NumSlots - Pending->NumSlots;
+		Pending->NumSlots = NumSlots;
+		Queue.PendingWeight -= FInventoryAggregates::ToFixedWeight(ItemData.ItemNumericData.Weight) * RemoveAmount;
+		AmountToRemove -= RemoveAmount;
+	}
+
+	// Then from the newest stacks, emptied stacks stay attached until the game thread detaches them
+	if (TArray<UItemBase*, TInlineAllocator<2>>* Stacks = StacksByID.Find(ItemData.ID)) {
+		for (int32 Index = Stacks->Num() - 1; Index >= 0 && AmountToRemove > 0; --Index) {
+			UItemBase* Stack = (*Stacks)[Index];
+			const int32 RemoveAmount = FMath::Min(Stack->Quantity, AmountToRemove);
+			if (RemoveAmount <= 0) {
+				continue;
+			}
+			Stack->Quantity -= RemoveAmount;
+			Aggregates.AccountItem(Stack, -RemoveAmount);
+			AmountToRemove -= RemoveAmount;
+			if (Stack->Quantity == 0) {
+				Queue.EmptiedStacks.Add(Stack);
+			}
+			else {
+				PendingChangeSet.MarkItemChanged(Stack);
+			}
+		}
+	}
+
+	Queue.AmountRemoved += Amount - AmountToRemove;
+}
+
+void UCpp_AC_Inventory::ApplyCommandResults(FInventoryCommandQueue& Queue) {
+	check(IsInGameThread());
+	FInventoryUpdateBatch UpdateBatch(this);
+
+	for (UItemBase* Stack : Queue.EmptiedStacks) {
+		// A later add in the same queue may have filled the stack again
+		if (Stack->Quantity == 0 && Stack->OwningInventory == this) {
+			DetachItem(Stack);
+			FCpp_ItemPool::Get().Release(Stack);
+		}
+	}
+
+	for (const FInventoryCommandQueue::FPendingStacks& Pending : Queue.PendingStacks) {
+		if (Pending.Amount > 0) {
+			UItemBase* NewItem = FCpp_ItemPool::Get().Acquire();
+			NewItem->InitializeFromItemData(*Pending.ItemData);
+			NewItem->Quantity = Pending.Amount;
+			// Slots emptied above may have freed room in partial stacks, ReceiveAmount fills those first
+			ReceiveAmount(NewItem, Pending.Amount, NewItem);
+		}
+	}
+
+	NotifyInventoryUpdated();
+}
+
+void UCpp_AC_Inventory::UpdateItemQuantity(const UItemBase* Item, const int32 OldQuantity) {
+	Aggregates.AccountItem(Item, Item->Quantity - OldQuantity);
+	PendingChangeSet.MarkItemChanged(Item);
+}
+
+void UCpp_AC_Inventory::NotifyInventoryUpdated() {
+	if (UpdateBatchDepth > 0) {
+		bPendingUpdateBroadcast = true;
+		return;
+	}
+	ValidateAggregates();
+
+	// Copied out so listeners reacting to the broadcast can start a new change set
+	const FInventoryChangeSet ChangeSet = MoveTemp(PendingChangeSet);
+	PendingChangeSet.Reset();
 	OnInventoryUpdated.Broadcast();
+	OnInventoryChanged.Broadcast(ChangeSet);
+}
+
+void UCpp_AC_Inventory::BeginUpdateBatch() {
+	++UpdateBatchDepth;
+}
+
+void UCpp_AC_Inventory::EndUpdateBatch() {
+	check(UpdateBatchDepth > 0);
+	if (--UpdateBatchDepth == 0 && bPendingUpdateBroadcast) {
+		bPendingUpdateBroadcast = false;
+		NotifyInventoryUpdated();
+	}
+}
+
+void UCpp_AC_Inventory::ValidateAggregates() const {
+#if !UE_BUILD_SHIPPING
+	if (!CVarValidateInventoryAggregates.GetValueOnGameThread()) {
+		return;
+	}
+
+	FInventoryAggregates Recomputed;
+	int32 RecountedItems = 0;
+	for (int32 Slot = 0; Slot < InventoryContents.Num(); ++Slot) {
+		if (const UItemBase* InventoryItem = InventoryContents[Slot]) {
+			Recomputed.AccountItem(InventoryItem, InventoryItem->Quantity);
+			ensureAlwaysMsgf(InventoryItem->SlotIndex == Slot, TEXT("%s Inventory item %s is in slot %d but thinks it is in slot %d!"),
+				*GetNameSafe(GetOwner()), *InventoryItem->ID.ToString(), Slot, InventoryItem->SlotIndex);
+			++RecountedItems;
+		}
+	}
+	ensureAlwaysMsgf(RecountedItems == NumItems, TEXT("%s Inventory holds %d stacks but counts %d!"), *GetNameSafe(GetOwner()), RecountedItems, NumItems);
+	ensureAlwaysMsgf(Recomputed == Aggregates, TEXT("%s Inventory aggregates drifted! Incremental Weight %lld Quantity %d, Recomputed Weight %lld Quantity %d"),
+		*GetNameSafe(GetOwner()), Aggregates.TotalWeight, Aggregates.TotalQuantity, Recomputed.TotalWeight, Recomputed.TotalQuantity);
+#endif
 }
 
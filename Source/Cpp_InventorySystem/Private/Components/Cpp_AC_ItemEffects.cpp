@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/Cpp_AC_ItemEffects.h"
+#include "Components/Cpp_AC_Inventory.h"
+#include "ItemBase.h"
+#include "../Cpp_InventorySystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Apply Item Effects"), STAT_ApplyItemEffects, STATGROUP_Inventory);
+
+UCpp_AC_ItemEffects::UCpp_AC_ItemEffects() {
+	// Only ticks while there is something to apply or a cooldown to count down, see UpdateTickEnabled
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	Health = 100.0f;
+	MaxHealth = 100.0f;
+	for (float& UseCooldown : UseCooldownByType) {
+		UseCooldown = 0.0f;
+	}
+}
+
+bool UCpp_AC_ItemEffects::CanUseItem(const UItemBase* Item) const {
+	return Item
+		&& Item->Quantity > 0
+		&& Item->ItemType == EItemType::Consumable
+		&& (Item->ItemStatistics.RestorationValue != 0.0f || Item->ItemStatistics.DamageValue != 0.0f)
+		&& !Cooldowns.Contains(Item->ID);
+}
+
+int32 UCpp_AC_ItemEffects::UseItem(UItemBase* Item, const int32 Amount) {
+	if (Amount <= 0 || !CanUseItem(Item)) {
+		return 0;
+	}
+
+	const float UseCooldown = UseCooldownByType[static_cast<int32>(Item->ItemType)];
+	const int32 UseAmount = UseCooldown > 0.0f ? 1 : FMath::Min(Amount, Item->Quantity);
+
+	// Spamming the same item only bumps the count of its record, nothing is allocated per use
+	if (FItemEffectRecord* Record = PendingEffects.FindByPredicate([Item](const FItemEffectRecord& Effect) { return Effect.ItemID == Item->ID; })) {
+		Record->Count += UseAmount;
+	}
+	else {
+		PendingEffects.Add({Item->ID, Item->ItemStatistics.RestorationValue, Item->ItemStatistics.DamageValue, UseAmount});
+	}
+
+	if (UseCooldown > 0.0f) {
+		Cooldowns.Add(Item->ID, CooldownWheel.Schedule(UseCooldown, Item->ID));
+	}
+
+	// The record holds everything the effect needs, so the stack can be emptied (and recycled) right away
+	if (UCpp_AC_Inventory* Inventory = Item->OwningInventory) {
+		Inventory->RemoveAmountOfItem(Item, UseAmount);
+	}
+	else {
+		Item->SetQuantity(Item->Quantity - UseAmount);
+	}
+
+	UpdateTickEnabled();
+	return UseAmount;
+}
+
+float UCpp_AC_ItemEffects::GetCooldownRemaining(const FName ItemID) const {
+	if (const FCpp_TimerWheelHandle* CooldownHandle = Cooldowns.Find(ItemID)) {
+		return CooldownWheel.GetRemainingTime(*CooldownHandle);
+	}
+	return 0.0f;
+}
+
+void UCpp_AC_ItemEffects::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) {
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	ApplyPendingEffects();
+
+	CooldownWheel.Advance(DeltaTime, [this](const FCpp_TimerWheelHandle& CooldownHandle, const FName& ItemID) {
+		const FCpp_TimerWheelHandle* CurrentHandle = Cooldowns.Find(ItemID);
+		if (CurrentHandle && *CurrentHandle == CooldownHandle) {
+			Cooldowns.Remove(ItemID);
+		}
+	});
+
+	UpdateTickEnabled();
+}
+
+void UCpp_AC_ItemEffects::ApplyPendingEffects() {
+	if (PendingEffects.IsEmpty()) {
+		return;
+	}
+	SCOPE_CYCLE_COUNTER(STAT_ApplyItemEffects);
+
+	float HealthDelta = 0.0f;
+	for (const FItemEffectRecord& Effect : PendingEffects) {
+		HealthDelta += (Effect.Restoration - Effect.Damage) * Effect.Count;
+	}
+	PendingEffects.Reset();
+
+	const float OldHealth = Health;
+	Health = FMath::Clamp(Health + HealthDelta, 0.0f, MaxHealth);
+	if (Health != OldHealth) {
+		OnHealthChanged.Broadcast(Health, Health - OldHealth);
+	}
+}
+
+void UCpp_AC_ItemEffects::UpdateTickEnabled() {
+	const bool bNeedsTick = !PendingEffects.IsEmpty() || !CooldownWheel.IsEmpty();
+	if (IsComponentTickEnabled() != bNeedsTick) {
+		SetComponentTickEnabled(bNeedsTick);
+	}
+}
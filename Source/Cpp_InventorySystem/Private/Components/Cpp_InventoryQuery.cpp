@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/Cpp_InventoryQuery.h"
+#include "ItemBase.h"
+#include "Algo/BinarySearch.h"
+
+bool FInventoryQuery::MatchesItem(const UItemBase* Item) const {
+	if (TypeMask != 0 && !(TypeMask & (1u << static_cast<uint32>(Item->ItemType)))) {
+		return false;
+	}
+	if (QualityMask != 0 && !(QualityMask & (1u << static_cast<uint32>(Item->ItemQuality)))) {
+		return false;
+	}
+
+	for (const FItemStatisticRange& Range : StatisticRanges) {
+		float Value = 0.0f;
+		switch (Range.Statistic) {
+			case EItemStatistic::ArmorRating:
+				Value = Item->ItemStatistics.ArmorRating;
+				break;
+			case EItemStatistic::DamageValue:
+				Value = Item->ItemStatistics.DamageValue;
+				break;
+			case EItemStatistic::RestorationValue:
+				Value = Item->ItemStatistics.RestorationValue;
+				break;
+			case EItemStatistic::SellValue:
+				Value = Item->ItemStatistics.SellValue;
+				break;
+		}
+		if (Value < Range.Min || Value > Range.Max) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FInventoryQueryIndex::AddItem(UItemBase* Item, const int32 Slot) {
+	SetSlot(Item, Slot);
+
+	FString Key = Item->ItemTextData.ItemName.ToString().ToLower();
+	const int32 InsertIndex = Algo::UpperBoundBy(NameIndex, Key, &FNameEntry::Key);
+	NameIndex.Insert({MoveTemp(Key), Item}, InsertIndex);
+}
+
+void FInventoryQueryIndex::SetSlot(const UItemBase* Item, const int32 Slot) {
+	if (bSlotsDirty) {
+		return;
+	}
+	// Slots past the end are new, the ones in between are empty
+	if (Slot >= TypeBits[0].Num()) {
+		const int32 NumNewBits = Slot + 1 - TypeBits[0].Num();
+		for (TBitArray<>& Bits : TypeBits) {
+			Bits.Add(false, NumNewBits);
+		}
+		for (TBitArray<>& Bits : QualityBits) {
+			Bits.Add(false, NumNewBits);
+		}
+	}
+	for (int32 TypeIndex = 0; TypeIndex < NumItemTypes; ++TypeIndex) {
+		TypeBits[TypeIndex][Slot] = TypeIndex == static_cast<int32>(Item->ItemType);
+	}
+	for (int32 QualityIndex = 0; QualityIndex < NumItemQualities; ++QualityIndex) {
+		QualityBits[QualityIndex][Slot] = QualityIndex == static_cast<int32>(Item->ItemQuality);
+	}
+}
+
+void FInventoryQueryIndex::ClearSlot(const int32 Slot) {
+	if (bSlotsDirty || Slot >= TypeBits[0].Num()) {
+		return;
+	}
+	for (TBitArray<>& Bits : TypeBits) {
+		Bits[Slot] = false;
+	}
+	for (TBitArray<>& Bits : QualityBits) {
+		Bits[Slot] = false;
+	}
+}
+
+void FInventoryQueryIndex::RemoveName(const UItemBase* Item) {
+	const FString Key = Item->ItemTextData.ItemName.ToString().ToLower();
+	// Only the run of entries with the same name has to be searched for the item
+	for (int32 Index = Algo::LowerBoundBy(NameIndex, Key, &FNameEntry::Key); Index < NameIndex.Num() && NameIndex[Index].Key == Key; ++Index) {
+		if (NameIndex[Index].Item == Item) {
+			NameIndex.RemoveAt(Index, 1, false);
+			return;
+		}
+	}
+}
+
+void FInventoryQueryIndex::Reset() {
+	for (TBitArray<>& Bits : TypeBits) {
+		Bits.Empty();
+	}
+	for (TBitArray<>& Bits : QualityBits) {
+		Bits.Empty();
+	}
+	NameIndex.Empty();
+	Results.Empty();
+	bSlotsDirty = false;
+}
+
+void FInventoryQueryIndex::RebuildSlots(TConstArrayView<TObjectPtr<UItemBase>> Contents) {
+	for (TBitArray<>& Bits : TypeBits) {
+		Bits.Init(false, Contents.Num());
+	}
+	for (TBitArray<>& Bits : QualityBits) {
+		Bits.Init(false, Contents.Num());
+	}
+	for (int32 Slot = 0; Slot < Contents.Num(); ++Slot) {
+		if (!Contents[Slot]) {
+			continue;
+		}
+		TypeBits[static_cast<int32>(Contents[Slot]->ItemType)][Slot] = true;
+		QualityBits[static_cast<int32>(Contents[Slot]->ItemQuality)][Slot] = true;
+	}
+	bSlotsDirty = false;
+}
+
+void FInventoryQueryIndex::BuildMask(TBitArray<>& OutMask, const TBitArray<>* Bitsets, const int32 NumBitsets, const uint32 Mask, const int32 NumSlots) const {
+	if (Mask == 0) {
+		OutMask.Init(true, NumSlots);
+		return;
+	}
+
+	OutMask.Init(false, NumSlots);
+	for (int32 Index = 0; Index < NumBitsets; ++Index) {
+		if (Mask & (1u << Index)) {
+			OutMask.CombineWithBitwiseOR(Bitsets[Index], EBitwiseOperatorFlags::MinSize);
+		}
+	}
+}
+
+TConstArrayView<UItemBase*> FInventoryQueryIndex::Run(const FInventoryQuery& Query, TConstArrayView<TObjectPtr<UItemBase>> Contents) {
+	Results.Reset();
+
+	if (!Query.NamePrefix.IsEmpty()) {
+		// Search as you type, walk the sorted names that start with the prefix and check the rest per item
+		for (int32 Index = Algo::LowerBoundBy(NameIndex, Query.NamePrefix, &FNameEntry::Key);
+			 Index < NameIndex.Num() && NameIndex[Index].Key.StartsWith(Query.NamePrefix, ESearchCase::CaseSensitive); ++Index) {
+			if (Query.MatchesItem(NameIndex[Index].Item)) {
+				Results.Add(NameIndex[Index].Item);
+			}
+		}
+		return Results;
+	}
+
+	if (bSlotsDirty) {
+		RebuildSlots(Contents);
+	}
+
+	// Type and quality are answered a word at a time by the bitsets, only the survivors are looked at
+	BuildMask(TypeMaskBits, TypeBits, NumItemTypes, Query.TypeMask, Contents.Num());
+	BuildMask(QualityMaskBits, QualityBits, NumItemQualities, Query.QualityMask, Contents.Num());
+	TypeMaskBits.CombineWithBitwiseAND(QualityMaskBits, EBitwiseOperatorFlags::MinSize);
+
+	for (TConstSetBitIterator<> It(TypeMaskBits); It; ++It) {
+		UItemBase* Item = Contents[It.GetIndex()];
+		// An empty filter selects every slot, holes included
+		if (Item && (Query.StatisticRanges.IsEmpty() || Query.MatchesItem(Item))) {
+			Results.Add(Item);
+		}
+	}
+	return Results;
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Cpp_ItemPool.h"
+#include "ItemBase.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommand ItemPoolStatsCommand(
+	TEXT("Inventory.ItemPool.Stats"),
+	TEXT("Logs how many items the item pool created, reused and discarded."),
+	FConsoleCommandDelegate::CreateLambda([]() {
+		FCpp_ItemPool::Get().LogStats();
+	}));
+
+FCpp_ItemPool& FCpp_ItemPool::Get() {
+	static FCpp_ItemPool ItemPool;
+	return ItemPool;
+}
+
+FCpp_ItemPool::~FCpp_ItemPool() {
+	if (PendingReleaseTickerHandle.IsValid()) {
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingReleaseTickerHandle);
+	}
+}
+
+UItemBase* FCpp_ItemPool::Acquire() {
+	check(IsInGameThread());
+
+	if (!FreeItems.IsEmpty()) {
+		++Stats.NumReused;
+		Stats.NumFree = FreeItems.Num() - 1;
+		return FreeItems.Pop(false);
+	}
+
+	++Stats.NumCreated;
+	return NewObject<UItemBase>(GetTransientPackage(), UItemBase::StaticClass());
+}
+
+void FCpp_ItemPool::Release(UItemBase* Item) {
+	check(IsInGameThread());
+
+	// Items outered to a pickup or of a subclass go back to the garbage collector
+	if (!Item || Item->GetOuter() != GetTransientPackage() || Item->GetClass() != UItemBase::StaticClass()) {
+		++Stats.NumDiscarded;
+		return;
+	}
+
+	PendingReleases.AddUnique(Item);
+	Stats.NumPendingRelease = PendingReleases.Num();
+	if (!PendingReleaseTickerHandle.IsValid()) {
+		PendingReleaseTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCpp_ItemPool::ProcessPendingReleases));
+	}
+}
+
+bool FCpp_ItemPool::ProcessPendingReleases(float DeltaTime) {
+	for (UItemBase* Item : PendingReleases) {
+		// Something picked the item back up since it was released (eg. it was added to an inventory again)
+		if (Item->OwningInventory || Item->Quantity > 0) {
+			continue;
+		}
+
+		++Stats.NumReleased;
+		if (FreeItems.Num() < MaxPooledItems) {
+			Item->ResetForReuse();
+			FreeItems.Add(Item);
+		}
+		else {
+			++Stats.NumDiscarded;
+		}
+	}
+	PendingReleases.Reset();
+
+	Stats.NumFree = FreeItems.Num();
+	Stats.NumPendingRelease = 0;
+	PendingReleaseTickerHandle.Reset();
+	// One shot, the ticker is added again by the next release
+	return false;
+}
+
+void FCpp_ItemPool::LogStats() const {
+	UE_LOG(LogTemp, Display, TEXT("Item Pool: Created %d, Reused %d, Released %d, Discarded %d, Free %d, Pending %d"),
+		Stats.NumCreated, Stats.NumReused, Stats.NumReleased, Stats.NumDiscarded, Stats.NumFree, Stats.NumPendingRelease);
+}
+
+void FCpp_ItemPool::AddReferencedObjects(FReferenceCollector& Collector) {
+	Collector.AddReferencedObjects(FreeItems);
+	Collector.AddReferencedObjects(PendingReleases);
+}
+
+FString FCpp_ItemPool::GetReferencerName() const {
+	return TEXT("FCpp_ItemPool");
+}
@@ -0,0 +1,244 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/Cpp_ItemCatalog.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/DataTable.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FCpp_ItemCatalog::FCpp_ItemCatalog() :
+	Records(nullptr),
+	StringTable(nullptr),
+	StringTableSize(0),
+	NumRecords(0)
+{}
+
+FCpp_ItemCatalog::~FCpp_ItemCatalog() {
+	Close();
+}
+
+bool FCpp_ItemCatalog::Open(const FString& FilePath) {
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PlatformFile.OpenMapped(*FilePath));
+	if (!MappedFile) {
+		UE_LOG(LogTemp, Warning, TEXT("Item Catalog %s could not be mapped!"), *FilePath);
+		return false;
+	}
+
+	const int64 FileSize = MappedFile->GetFileSize();
+	if (FileSize < static_cast<int64>(sizeof(FItemCatalogHeader))) {
+		UE_LOG(LogTemp, Warning, TEXT("Item Catalog %s is too small to be valid!"), *FilePath);
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+	if (!MappedRegion) {
+		Close();
+		return false;
+	}
+
+	// Validate the header before trusting any of the offsets in it
+	const uint8* Data = MappedRegion->GetMappedPtr();
+	const FItemCatalogHeader* Header = reinterpret_cast<const FItemCatalogHeader*>(Data);
+	const uint64 RecordsEnd = Header->RecordsOffset + static_cast<uint64>(Header->NumRecords) * sizeof(FItemCatalogRecord);
+	const uint64 StringTableEnd = static_cast<uint64>(Header->StringTableOffset) + Header->StringTableSize;
+
+	if (Header->Magic != CatalogMagic || Header->Version != CatalogVersion
+		|| RecordsEnd > static_cast<uint64>(FileSize) || StringTableEnd > static_cast<uint64>(FileSize)
+		|| Header->RecordsOffset % alignof(FItemCatalogRecord) != 0) {
+		UE_LOG(LogTemp, Warning, TEXT("Item Catalog %s has an invalid header!"), *FilePath);
+		Close();
+		return false;
+	}
+
+	Records = reinterpret_cast<const FItemCatalogRecord*>(Data + Header->RecordsOffset);
+	StringTable = Data + Header->StringTableOffset;
+	StringTableSize = Header->StringTableSize;
+	NumRecords = Header->NumRecords;
+	return true;
+}
+
+void FCpp_ItemCatalog::Close() {
+	// The region has to be released before the file handle that owns it
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Records = nullptr;
+	StringTable = nullptr;
+	StringTableSize = 0;
+	NumRecords = 0;
+}
+
+uint64 FCpp_ItemCatalog::HashID(const FName ID) {
+	const FTCHARToUTF8 LowerID(*ID.ToString().ToLower());
+	return CityHash64(reinterpret_cast<const char*>(LowerID.Get()), LowerID.Length());
+}
+
+const FItemCatalogRecord* FCpp_ItemCatalog::FindRecord(const FName ID) const {
+	if (!IsOpen() || ID.IsNone()) {
+		return nullptr;
+	}
+
+	const uint64 Hash = HashID(ID);
+	const FString IDString = ID.ToString();
+
+	// Lower bound on the hash, then walk the (almost always single entry) run of equal hashes
+	int32 Low = 0;
+	int32 High = NumRecords;
+	while (Low < High) {
+		const int32 Middle = Low + (High - Low) / 2;
+		if (Records[Middle].IDHash < Hash) {
+			Low = Middle + 1;
+		}
+		else {
+			High = Middle;
+		}
+	}
+
+	for (int32 Index = Low; Index < NumRecords && Records[Index].IDHash == Hash; ++Index) {
+		if (GetString(Records[Index].ID).Equals(IDString, ESearchCase::IgnoreCase)) {
+			return &Records[Index];
+		}
+	}
+	return nullptr;
+}
+
+FString FCpp_ItemCatalog::GetString(const uint32 Offset) const {
+	if (!StringTable || static_cast<uint64>(Offset) + sizeof(uint32) > StringTableSize) {
+		return FString();
+	}
+
+	uint32 Length;
+	FMemory::Memcpy(&Length, StringTable + Offset, sizeof(uint32));
+	if (static_cast<uint64>(Offset) + sizeof(uint32) + Length > StringTableSize) {
+		return FString();
+	}
+
+	const auto Converted = StringCast<TCHAR>(reinterpret_cast<const UTF8CHAR*>(StringTable + Offset + sizeof(uint32)), Length);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+bool FCpp_ItemCatalog::FindItemData(const FName ID, FItemData& OutItemData, const bool bLoadAssets) const {
+	const FItemCatalogRecord* Record = FindRecord(ID);
+	if (!Record) {
+		return false;
+	}
+
+	OutItemData.ID = ID;
+	OutItemData.ItemType = static_cast<EItemType>(Record->ItemType);
+	OutItemData.ItemQuality = static_cast<EItemQuality>(Record->ItemQuality);
+
+	OutItemData.ItemStatistics.ArmorRating = Record->ArmorRating;
+	OutItemData.ItemStatistics.DamageValue = Record->DamageValue;
+	OutItemData.ItemStatistics.RestorationValue = Record->RestorationValue;
+	OutItemData.ItemStatistics.SellValue = Record->SellValue;
+
+	// Catalog text is baked in the source language, it does not go through the localization tables
+	OutItemData.ItemTextData.ItemName = FText::FromString(GetString(Record->ItemName));
+	OutItemData.ItemTextData.ItemDescription = FText::FromString(GetString(Record->ItemDescription));
+	OutItemData.ItemTextData.InteractionText = FText::FromString(GetString(Record->InteractionText));
+	OutItemData.ItemTextData.UsageText = FText::FromString(GetString(Record->UsageText));
+
+	OutItemData.ItemNumericData.MaxStackSize = Record->MaxStackSize;
+	OutItemData.ItemNumericData.Weight = Record->Weight;
+	OutItemData.ItemNumericData.bIsStackable = Record->bIsStackable != 0;
+
+	OutItemData.ItemAssetData.Icon = nullptr;
+	OutItemData.ItemAssetData.Mesh = nullptr;
+	if (bLoadAssets) {
+		OutItemData.ItemAssetData.Icon = Cast<UTexture2D>(FSoftObjectPath(GetString(Record->IconPath)).TryLoad());
+		OutItemData.ItemAssetData.Mesh = Cast<UStaticMesh>(FSoftObjectPath(GetString(Record->MeshPath)).TryLoad());
+	}
+	return true;
+}
+
+bool FCpp_ItemCatalog::WriteCatalog(const UDataTable* ItemTable, const FString& FilePath) {
+	if (!ItemTable) {
+		return false;
+	}
+
+	TArray<FItemCatalogRecord> OutRecords;
+	TArray<uint8> OutStrings;
+	// Identical strings (empty descriptions, shared usage texts...) are only stored once
+	TMap<FString, uint32> StringOffsets;
+
+	auto AddString = [&OutStrings, &StringOffsets](const FString& String) -> uint32 {
+		if (const uint32* ExistingOffset = StringOffsets.Find(String)) {
+			return *ExistingOffset;
+		}
+		const FTCHARToUTF8 Converted(*String);
+		const uint32 Offset = OutStrings.Num();
+		const uint32 Length = Converted.Length();
+		OutStrings.Append(reinterpret_cast<const uint8*>(&Length), sizeof(uint32));
+		OutStrings.Append(reinterpret_cast<const uint8*>(Converted.Get()), Length);
+		StringOffsets.Add(String, Offset);
+		return Offset;
+	};
+
+	ItemTable->ForeachRow<FItemData>(TEXT("FCpp_ItemCatalog::WriteCatalog"), [&OutRecords, &AddString](const FName& RowName, const FItemData& ItemData) {
+		FItemCatalogRecord& Record = OutRecords.AddZeroed_GetRef();
+		Record.IDHash = HashID(ItemData.ID);
+		Record.ID = AddString(ItemData.ID.ToString());
+		Record.ItemName = AddString(ItemData.ItemTextData.ItemName.ToString());
+		Record.ItemDescription = AddString(ItemData.ItemTextData.ItemDescription.ToString());
+		Record.InteractionText = AddString(ItemData.ItemTextData.InteractionText.ToString());
+		Record.UsageText = AddString(ItemData.ItemTextData.UsageText.ToString());
+		Record.IconPath = AddString(FSoftObjectPath(ItemData.ItemAssetData.Icon).ToString());
+		Record.MeshPath = AddString(FSoftObjectPath(ItemData.ItemAssetData.Mesh).ToString());
+
+		Record.ArmorRating = ItemData.ItemStatistics.ArmorRating;
+		Record.DamageValue = ItemData.ItemStatistics.DamageValue;
+		Record.RestorationValue = ItemData.ItemStatistics.RestorationValue;
+		Record.SellValue = ItemData.ItemStatistics.SellValue;
+
+		Record.MaxStackSize = ItemData.ItemNumericData.MaxStackSize;
+		Record.Weight = ItemData.ItemNumericData.Weight;
+		// Same rule the pickups use when initialising from the data table
+		Record.bIsStackable = ItemData.ItemNumericData.MaxStackSize > 1;
+
+		Record.ItemType = static_cast<uint8>(ItemData.ItemType);
+		Record.ItemQuality = static_cast<uint8>(ItemData.ItemQuality);
+	});
+
+	OutRecords.Sort([](const FItemCatalogRecord& A, const FItemCatalogRecord& B) {
+		return A.IDHash < B.IDHash;
+	});
+
+	FItemCatalogHeader Header;
+	Header.Magic = CatalogMagic;
+	Header.Version = CatalogVersion;
+	Header.NumRecords = OutRecords.Num();
+	Header.RecordsOffset = Align(sizeof(FItemCatalogHeader), alignof(FItemCatalogRecord));
+	Header.StringTableOffset = Header.RecordsOffset + OutRecords.Num() * sizeof(FItemCatalogRecord);
+	Header.StringTableSize = OutStrings.Num();
+
+	TArray<uint8> FileData;
+	FileData.AddZeroed(Header.StringTableOffset + Header.StringTableSize);
+	FMemory::Memcpy(FileData.GetData(), &Header, sizeof(FItemCatalogHeader));
+	FMemory::Memcpy(FileData.GetData() + Header.RecordsOffset, OutRecords.GetData(), OutRecords.Num() * sizeof(FItemCatalogRecord));
+	FMemory::Memcpy(FileData.GetData() + Header.StringTableOffset, OutStrings.GetData(), OutStrings.Num());
+
+	return FFileHelper::SaveArrayToFile(FileData, *FilePath);
+}
+
+void UCpp_ItemCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+	Super::Initialize(Collection);
+
+	const FString FullPath = FPaths::Combine(FPaths::ProjectContentDir(), CatalogPath);
+	if (FPaths::FileExists(FullPath)) {
+		Catalog.Open(FullPath);
+	}
+}
+
+void UCpp_ItemCatalogSubsystem::Deinitialize() {
+	Catalog.Close();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/Cpp_ItemIconAtlas.h"
+#include "ItemBase.h"
+#include "../Cpp_InventorySystem.h"
+#include "Components/Image.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+
+// Compare the two while a full grid is open, with the atlas set up the fallbacks should stay at 0.
+// Slate.ShowBatching 1 and stat Slate show the batches and draw elements they turn into.
+DECLARE_DWORD_COUNTER_STAT(TEXT("Atlas Icon Brushes Set"), STAT_AtlasIconBrushes, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Icon Texture Fallbacks"), STAT_IconTextureFallbacks, STATGROUP_Inventory);
+
+void UCpp_ItemIconAtlas::PostLoad() {
+	Super::PostLoad();
+
+	BuildBrushes();
+}
+
+const FSlateBrush* UCpp_ItemIconAtlas::FindIconBrush(const FName ItemID) const {
+	// Only an atlas that was never loaded or packed gets here unbuilt, skipped entries must not rebuild every lookup
+	if (!bBrushesBuilt) {
+		BuildBrushes();
+	}
+	return Brushes.Find(ItemID);
+}
+
+void UCpp_ItemIconAtlas::BuildBrushes() const {
+	Brushes.Reset();
+	Brushes.Reserve(Entries.Num());
+	for (const TPair<FName, FItemIconAtlasEntry>& Entry : Entries) {
+		if (!Pages.IsValidIndex(Entry.Value.Page) || !Pages[Entry.Value.Page]) {
+			continue;
+		}
+		FSlateBrush& Brush = Brushes.Add(Entry.Key);
+		Brush.SetResourceObject(Pages[Entry.Value.Page]);
+		Brush.DrawAs = ESlateBrushDrawType::Image;
+		Brush.ImageSize = FVector2D(IconSize, IconSize);
+		Brush.SetUVRegion(FBox2f(FVector2f(Entry.Value.UVMin), FVector2f(Entry.Value.UVMax)));
+	}
+	bBrushesBuilt = true;
+}
+
+#if WITH_EDITOR
+void UCpp_ItemIconAtlas::SetPackedContents(const int32 InIconSize, TArray<TObjectPtr<UTexture2D>>&& InPages, TMap<FName, FItemIconAtlasEntry>&& InEntries) {
+	IconSize = InIconSize;
+	Pages = MoveTemp(InPages);
+	Entries = MoveTemp(InEntries);
+	BuildBrushes();
+}
+#endif
+
+void UCpp_ItemIconSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+	Super::Initialize(Collection);
+
+	if (!IconAtlasAsset.IsNull()) {
+		IconAtlas = IconAtlasAsset.LoadSynchronous();
+		if (!IconAtlas) {
+			UE_LOG(LogTemp, Warning, TEXT("Item Icon Atlas %s could not be loaded, falling back to the item icon textures!"), *IconAtlasAsset.ToString());
+		}
+	}
+}
+
+void UCpp_ItemIconSubsystem::SetItemIcon(UImage* Image, const UItemBase* Item) {
+	if (!Image || !Item) {
+		return;
+	}
+
+	const UWorld* World = Image->GetWorld();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	const UCpp_ItemIconSubsystem* IconSubsystem = GameInstance ? GameInstance->GetSubsystem<UCpp_ItemIconSubsystem>() : nullptr;
+	if (IconSubsystem && IconSubsystem->IconAtlas) {
+		if (const FSlateBrush* AtlasBrush = IconSubsystem->IconAtlas->FindIconBrush(Item->ID)) {
+			INC_DWORD_STAT(STAT_AtlasIconBrushes);
+			// SetBrush compares against the current brush, showing the same icon again doesn't invalidate the image
+			Image->SetBrush(*AtlasBrush);
+			return;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_IconTextureFallbacks);
+	// SetBrushFromTexture keeps the UV region, an image that showed an atlas icon before would crop the texture to it
+	FSlateBrush TextureBrush = Image->GetBrush();
+	TextureBrush.SetResourceObject(Item->ItemAssetData.Icon);
+	TextureBrush.SetUVRegion(FBox2f(FVector2f::ZeroVector, FVector2f::UnitVector));
+	Image->SetBrush(TextureBrush);
+}
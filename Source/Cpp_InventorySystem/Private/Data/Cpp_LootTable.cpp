@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/Cpp_LootTable.h"
+#include "Components/Cpp_AC_Inventory.h"
+#include "ItemBase.h"
+#include "Cpp_ItemPool.h"
+#include "Subsystems/Cpp_PickupSpawnSubsystem.h"
+#include "Engine/World.h"
+
+void FLootAliasTable::Build(TConstArrayView<float> Weights) {
+	const int32 NumWeights = Weights.Num();
+	Probabilities.Reset();
+	Aliases.Reset();
+
+	double TotalWeight = 0.0;
+	for (const float Weight : Weights) {
+		TotalWeight += FMath::Max(Weight, 0.0f);
+	}
+	if (NumWeights == 0 || TotalWeight <= 0.0) {
+		return;
+	}
+
+	Probabilities.SetNumUninitialized(NumWeights);
+	Aliases.SetNumUninitialized(NumWeights);
+
+	// Scale the weights so the average is 1, then pair every under-full column with an over-full one
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(NumWeights);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 Index = 0; Index < NumWeights; ++Index) {
+		Scaled[Index] = FMath::Max(Weights[Index], 0.0f) * NumWeights / TotalWeight;
+		Aliases[Index] = Index;
+		(Scaled[Index] < 1.0 ? Small : Large).Add(Index);
+	}
+
+	while (!Small.IsEmpty() && !Large.IsEmpty()) {
+		const int32 SmallIndex = Small.Pop(false);
+		const int32 LargeIndex = Large.Pop(false);
+
+		Probabilities[SmallIndex] = static_cast<float>(Scaled[SmallIndex]);
+		Aliases[SmallIndex] = LargeIndex;
+
+		Scaled[LargeIndex] = (Scaled[LargeIndex] + Scaled[SmallIndex]) - 1.0;
+		(Scaled[LargeIndex] < 1.0 ? Small : Large).Add(LargeIndex);
+	}
+
+	// Whatever is left is 1 up to floating point error
+	for (const int32 Index : Large) {
+		Probabilities[Index] = 1.0f;
+	}
+	for (const int32 Index : Small) {
+		Probabilities[Index] = 1.0f;
+	}
+}
+
+int32 FLootAliasTable::Sample(const FRandomStream& RandomStream) const {
+	const int32 Column = RandomStream.RandHelper(Probabilities.Num());
+	return RandomStream.GetFraction() < Probabilities[Column] ? Column : Aliases[Column];
+}
+
+UCpp_LootTable::UCpp_LootTable() {
+	for (float& QualityWeight : QualityWeights) {
+		QualityWeight = 1.0f;
+	}
+}
+
+void UCpp_LootTable::PostLoad() {
+	Super::PostLoad();
+
+	BuildSamplingTable();
+}
+
+#if WITH_EDITOR
+void UCpp_LootTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) {
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BuildSamplingTable();
+}
+
+void UCpp_LootTable::UnwatchDataTables() {
+	for (const TWeakObjectPtr<UDataTable>& DataTable : WatchedDataTables) {
+		if (UDataTable* WatchedTable = DataTable.Get()) {
+			WatchedTable->OnDataTableChanged().RemoveAll(this);
+		}
+	}
+	WatchedDataTables.Reset();
+}
+
+void UCpp_LootTable::HandleItemDataTableChanged() {
+	// The rows ResolvedItems points at may have been freed, the table was emptied and refilled
+	BuildSamplingTable();
+}
+#endif
+
+void UCpp_LootTable::BuildSamplingTable() {
+	ResolvedItems.Reset(Entries.Num());
+#if WITH_EDITOR
+	UnwatchDataTables();
+#endif
+
+	TArray<float> EffectiveWeights;
+	EffectiveWeights.Reserve(Entries.Num());
+	for (const FLootTableEntry& Entry : Entries) {
+		const FItemData* ItemData = nullptr;
+		float Weight = Entry.Weight;
+		if (!Entry.NestedTable) {
+			ItemData = Entry.ItemRowHandle.IsNull() ? nullptr : Entry.ItemRowHandle.GetRow<FItemData>(TEXT("UCpp_LootTable::BuildSamplingTable"));
+#if WITH_EDITOR
+			// The handle only hands out a const table, the change delegate doesn't modify it
+			UDataTable* ItemDataTable = const_cast<UDataTable*>(Entry.ItemRowHandle.DataTable.Get());
+			if (ItemDataTable && !WatchedDataTables.Contains(ItemDataTable)) {
+				WatchedDataTables.Add(ItemDataTable);
+				ItemDataTable->OnDataTableChanged().AddUObject(this, &UCpp_LootTable::HandleItemDataTableChanged);
+			}
+#endif
+			// Entries without an item can never drop anything
+			Weight = ItemData ? Weight * QualityWeights[static_cast<int32>(ItemData->ItemQuality)] : 0.0f;
+		}
+		ResolvedItems.Add(ItemData);
+		EffectiveWeights.Add(Weight);
+	}
+
+	AliasTable.Build(EffectiveWeights);
+}
+
+void UCpp_LootTable::RollDrops(FRandomStream& RandomStream, TArray<FLootDrop>& OutDrops) const {
+	RollDrops(RandomStream, OutDrops, 0);
+}
+
+void UCpp_LootTable::RollDrops(FRandomStream& RandomStream, TArray<FLootDrop>& OutDrops, const int32 Depth) const {
+	if (AliasTable.IsEmpty() || Depth > MaxNestingDepth) {
+		return;
+	}
+
+	const int32 NumRolls = RandomStream.RandRange(MinRolls, FMath::Max(MinRolls, MaxRolls));
+	for (int32 Roll = 0; Roll < NumRolls; ++Roll) {
+		const int32 EntryIndex = AliasTable.Sample(RandomStream);
+		const FLootTableEntry& Entry = Entries[EntryIndex];
+
+		if (Entry.NestedTable) {
+			Entry.NestedTable->RollDrops(RandomStream, OutDrops, Depth + 1);
+		}
+		else if (const FItemData* ItemData = ResolvedItems[EntryIndex]) {
+			const int32 Quantity = RandomStream.RandRange(Entry.MinQuantity, FMath::Max(Entry.MinQuantity, Entry.MaxQuantity));
+			OutDrops.Add({ItemData, Quantity});
+		}
+	}
+}
+
+int32 UCpp_LootTable::RollIntoInventory(const int32 Seed, UCpp_AC_Inventory* Inventory) const {
+	if (!Inventory) {
+		return 0;
+	}
+
+	// Reused across calls, bulk rolls don't allocate once it has grown to the largest roll
+	static TArray<FLootDrop> Drops;
+	check(IsInGameThread());
+	Drops.Reset();
+
+	FRandomStream RandomStream(Seed);
+	RollDrops(RandomStream, Drops);
+
+	FInventoryUpdateBatch UpdateBatch(Inventory);
+	int32 TotalAdded = 0;
+	for (const FLootDrop& Drop : Drops) {
+		TotalAdded += Inventory->AddAmountOfItem(*Drop.ItemData, Drop.Quantity);
+	}
+	return TotalAdded;
+}
+
+void UCpp_LootTable::SpawnPickups(UWorld* World, const int32 Seed, const FTransform& Origin, const float ScatterRadius) const {
+	if (!World) {
+		return;
+	}
+
+	static TArray<FLootDrop> Drops;
+	check(IsInGameThread());
+	Drops.Reset();
+
+	FRandomStream RandomStream(Seed);
+	RollDrops(RandomStream, Drops);
+
+	for (const FLootDrop& Drop : Drops) {
+		// A pickup holds a single stack, anything above the stack size is split over several pickups
+		const int32 MaxStackSize = Drop.ItemData->ItemNumericData.MaxStackSize > 1 ? Drop.ItemData->ItemNumericData.MaxStackSize : 1;
+		for (int32 Remaining = Drop.Quantity; Remaining > 0; Remaining -= MaxStackSize) {
+			// Uniform over the disc, the square root keeps the drops from bunching up in the middle
+			const float Distance = ScatterRadius * FMath::Sqrt(RandomStream.FRand());
+			float Sin, Cos;
+			FMath::SinCos(&Sin, &Cos, RandomStream.FRand() * UE_TWO_PI);
+			const FTransform SpawnTransform(Origin.GetRotation(), Origin.GetLocation() + FVector(Cos * Distance, Sin * Distance, 0.0f));
+
+			UItemBase* DroppedItem = FCpp_ItemPool::Get().Acquire();
+			DroppedItem->InitializeFromItemData(*Drop.ItemData);
+
+			// Large rolls are spread over several frames by the spawn queue
+			UCpp_PickupSpawnSubsystem::SpawnDrop(World, DroppedItem, FMath::Min(Remaining, MaxStackSize), SpawnTransform);
+		}
+	}
+}
@@ -3,15 +3,19 @@
 
 #include "ItemBase.h"
 #include "Components/Cpp_AC_Inventory.h"
+#include "Cpp_ItemPool.h"
+#include "../Cpp_InventorySystemCharacter.h"
 
 UItemBase::UItemBase() {
+	SlotIndex = INDEX_NONE;
 	bIsCopy = false;
 	bIsPickup = true;
 }
 
 UItemBase* UItemBase::CreateItemCopy()
 {	
-    UItemBase* NewItem = NewObject<UItemBase>(GetTransientPackage(), UItemBase::StaticClass());
+    // Recycled from the item pool when possible instead of creating a new UObject for every split and partial pickup
+    UItemBase* NewItem = FCpp_ItemPool::Get().Acquire();
     if (NewItem) {		     
         NewItem->Quantity = Quantity;
         NewItem->ID = ID;
@@ -26,17 +30,47 @@ UItemBase* UItemBase::CreateItemCopy()
     return NewItem;
 }
 
+void UItemBase::InitializeFromItemData(const FItemData& ItemData) {
+	ID = ItemData.ID;
+	ItemQuality = ItemData.ItemQuality;
+	ItemTextData = ItemData.ItemTextData;
+	ItemType = ItemData.ItemType;
+	ItemAssetData = ItemData.ItemAssetData;
+	ItemNumericData = ItemData.ItemNumericData;
+	ItemStatistics = ItemData.ItemStatistics;
+	// Sets whether the item is stackable or not 
+	ItemNumericData.bIsStackable = ItemData.ItemNumericData.MaxStackSize > 1;
+}
+
 void UItemBase::ResetItemFlags() {
 	bIsCopy = false;
 	bIsPickup = false;
 }
 
+void UItemBase::ResetForReuse() {
+	OwningInventory = nullptr;
+	SlotIndex = INDEX_NONE;
+	Quantity = 0;
+	ID = NAME_None;
+	ItemType = EItemType::Weapon;
+	ItemQuality = EItemQuality::Common;
+	ItemStatistics = FItemStatistics();
+	ItemTextData = FItemTextData();
+	ItemNumericData = FItemNumericData();
+	ItemAssetData = FItemAssetData();
+	bIsCopy = false;
+	bIsPickup = true;
+}
+
 void UItemBase::SetQuantity(const int32 NewQuantity) {
 	if (NewQuantity != Quantity) {
+		const int32 OldQuantity = Quantity;
 		// Clamp the quantity to be between 0 and the max stack size only if the item is stackable
 		Quantity = FMath::Clamp(NewQuantity, 0, ItemNumericData.bIsStackable ? ItemNumericData.MaxStackSize : 1);
 
 		if(OwningInventory) {
+			// Keep the inventory weight and quantity totals in sync with the stack
+			OwningInventory->UpdateItemQuantity(this, OldQuantity);
 			if(Quantity == 0) {
 				OwningInventory->RemoveSingleInstanceOfItem(this);
 			}
@@ -48,5 +82,8 @@ void UItemBase::SetQuantity(const int32 NewQuantity) {
 }
 
 void UItemBase::Use(ACpp_InventorySystemCharacter* Character) {
-
+	// The effect comes from the item statistics, subclasses override this for anything the statistics can't describe
+	if (Character) {
+		Character->UseItem(this, 1);
+	}
 }
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Cpp_FocusHighlightSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "../Cpp_InventorySystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Focus Highlight Updates"), STAT_FocusHighlightUpdates, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<float> CVarFocusHighlightReleaseDelay(
+	TEXT("Inventory.FocusHighlight.ReleaseDelay"),
+	0.25f,
+	TEXT("Seconds an interactable keeps its focus outline after losing focus. Longer than the interaction check interval,\n")
+	TEXT("so a trace that misses for a single check doesn't turn the outline off and on again."));
+
+void UCpp_FocusHighlightSubsystem::SetFocusHighlight(UPrimitiveComponent* Component, const bool bHighlighted, const int32 StencilValue) {
+	if (!Component) {
+		return;
+	}
+	const UWorld* World = Component->GetWorld();
+	if (UCpp_FocusHighlightSubsystem* FocusHighlights = World ? World->GetSubsystem<UCpp_FocusHighlightSubsystem>() : nullptr) {
+		bHighlighted ? FocusHighlights->RequestHighlight(Component, StencilValue) : FocusHighlights->ReleaseHighlight(Component);
+	}
+	else {
+		ApplyHighlight(Component, bHighlighted, StencilValue);
+	}
+}
+
+void UCpp_FocusHighlightSubsystem::RequestHighlight(UPrimitiveComponent* Component, const int32 StencilValue) {
+	if (!Component) {
+		return;
+	}
+	FHighlightState& State = Highlights.FindOrAdd(Component);
+	State.bWanted = true;
+	if (StencilValue != INDEX_NONE && StencilValue != State.StencilValue) {
+		State.StencilValue = StencilValue;
+		// Forces the entry through the next flush even when custom depth is already on
+		State.bApplied = false;
+	}
+	// Refocused within the release delay, the outline never went off and nothing has to be updated
+	if (!State.bApplied) {
+		++NumUnsettled;
+	}
+}
+
+void UCpp_FocusHighlightSubsystem::ReleaseHighlight(UPrimitiveComponent* Component) {
+	FHighlightState* State = Highlights.Find(Component);
+	if (!State || !State->bWanted) {
+		return;
+	}
+	State->bWanted = false;
+	State->ReleaseTime = GetWorld()->GetTimeSeconds() + FMath::Max(CVarFocusHighlightReleaseDelay.GetValueOnGameThread(), 0.0f);
+	++NumUnsettled;
+}
+
+void UCpp_FocusHighlightSubsystem::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	int32 NumUpdates = 0;
+	for (auto It = Highlights.CreateIterator(); It; ++It) {
+		UPrimitiveComponent* Component = It.Key().Get();
+		FHighlightState& State = It.Value();
+		if (!Component) {
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (State.bWanted) {
+			if (!State.bApplied) {
+				ApplyHighlight(Component, true, State.StencilValue);
+				State.bApplied = true;
+				++NumUpdates;
+			}
+		}
+		else if (Now >= State.ReleaseTime) {
+			if (State.bApplied) {
+				ApplyHighlight(Component, false, INDEX_NONE);
+				++NumUpdates;
+			}
+			It.RemoveCurrent();
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_FocusHighlightUpdates, NumUpdates);
+
+	RecountUnsettled();
+}
+
+void UCpp_FocusHighlightSubsystem::RecountUnsettled() {
+	// Only a handful of components are ever highlighted at once, recounting is cheaper than keeping exact bookkeeping
+	NumUnsettled = 0;
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, FHighlightState>& Highlight : Highlights) {
+		if (!Highlight.Value.bWanted || !Highlight.Value.bApplied || !Highlight.Key.IsValid()) {
+			++NumUnsettled;
+		}
+	}
+}
+
+void UCpp_FocusHighlightSubsystem::ApplyHighlight(UPrimitiveComponent* Component, const bool bHighlighted, const int32 StencilValue) {
+	// Both setters only mark the render state dirty, it is recreated once at the end of the frame however many were called
+	if (StencilValue != INDEX_NONE && Component->CustomDepthStencilValue != StencilValue) {
+		Component->SetCustomDepthStencilValue(StencilValue);
+	}
+	if (Component->bRenderCustomDepth != bHighlighted) {
+		Component->SetRenderCustomDepth(bHighlighted);
+	}
+}
+
+void UCpp_FocusHighlightSubsystem::Deinitialize() {
+	Highlights.Reset();
+	NumUnsettled = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UCpp_FocusHighlightSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCpp_FocusHighlightSubsystem, STATGROUP_Inventory);
+}
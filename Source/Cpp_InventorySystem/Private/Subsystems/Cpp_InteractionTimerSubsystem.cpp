@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Cpp_InteractionTimerSubsystem.h"
+#include "../Cpp_InventorySystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Timed Interactions"), STAT_ActiveTimedInteractions, STATGROUP_Inventory);
+
+// Fine enough for a progress bar, interaction durations are tenths of a second and up
+UCpp_InteractionTimerSubsystem::UCpp_InteractionTimerSubsystem() : InteractionTimers(1.0f / 60.0f) {
+
+}
+
+FCpp_TimerWheelHandle UCpp_InteractionTimerSubsystem::StartInteraction(const float Duration, FSimpleDelegate OnCompleted, FOnInteractionProgress OnProgress) {
+	INC_DWORD_STAT(STAT_ActiveTimedInteractions);
+	const FCpp_TimerWheelHandle Handle = InteractionTimers.Schedule(Duration, OnCompleted);
+	if (OnProgress.IsBound()) {
+		OnProgress.Execute(0.0f);
+		WatchedInteractions.Add({Handle, MoveTemp(OnProgress), 0.0f});
+	}
+	return Handle;
+}
+
+bool UCpp_InteractionTimerSubsystem::CancelInteraction(FCpp_TimerWheelHandle& Handle) {
+	const FCpp_TimerWheelHandle CancelledHandle = Handle;
+	if (InteractionTimers.Cancel(Handle)) {
+		DEC_DWORD_STAT(STAT_ActiveTimedInteractions);
+		RemoveWatchedInteraction(CancelledHandle, false);
+		return true;
+	}
+	return false;
+}
+
+void UCpp_InteractionTimerSubsystem::RemoveWatchedInteraction(const FCpp_TimerWheelHandle& Handle, const bool bCompleted) {
+	for (int32 Index = 0; Index < WatchedInteractions.Num(); ++Index) {
+		if (WatchedInteractions[Index].Handle == Handle) {
+			if (bCompleted && WatchedInteractions[Index].LastProgress < 1.0f) {
+				WatchedInteractions[Index].OnProgress.ExecuteIfBound(1.0f);
+			}
+			WatchedInteractions.RemoveAtSwap(Index, 1, false);
+			return;
+		}
+	}
+}
+
+void UCpp_InteractionTimerSubsystem::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	InteractionTimers.Advance(DeltaTime, [this](const FCpp_TimerWheelHandle& Handle, FSimpleDelegate& OnCompleted) {
+		DEC_DWORD_STAT(STAT_ActiveTimedInteractions);
+		if (!WatchedInteractions.IsEmpty()) {
+			RemoveWatchedInteraction(Handle, true);
+		}
+		OnCompleted.ExecuteIfBound();
+	});
+
+	// Pushed only when the value changed, listeners don't have to poll or compare.
+	// Walked backwards as a listener may cancel its interaction from the callback.
+	for (int32 Index = WatchedInteractions.Num() - 1; Index >= 0; --Index) {
+		FWatchedInteraction& Watched = WatchedInteractions[Index];
+		const float Progress = InteractionTimers.GetElapsedFraction(Watched.Handle);
+		if (Progress != Watched.LastProgress) {
+			Watched.LastProgress = Progress;
+			Watched.OnProgress.ExecuteIfBound(Progress);
+		}
+	}
+}
+
+TStatId UCpp_InteractionTimerSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCpp_InteractionTimerSubsystem, STATGROUP_Inventory);
+}
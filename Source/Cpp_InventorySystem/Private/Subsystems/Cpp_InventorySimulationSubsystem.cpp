@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Cpp_InventorySimulationSubsystem.h"
+#include "Components/Cpp_AC_Inventory.h"
+#include "../Cpp_InventorySystem.h"
+#include "../ItemDataStructs.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DefaultValueHelper.h"
+
+DECLARE_CYCLE_STAT(TEXT("Simulation Execute"), STAT_InventorySimulationExecute, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("Simulation Apply"), STAT_InventorySimulationApply, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Inventories"), STAT_InventorySimulationInventories, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Commands"), STAT_InventorySimulationCommands, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<bool> CVarInventorySimulationParallel(
+	TEXT("Inventory.Simulation.Parallel"),
+	true,
+	TEXT("Runs the queued inventory commands of different inventories on worker threads."));
+
+static FAutoConsoleCommand InventorySimulationBenchmarkCommand(
+	TEXT("Inventory.Simulation.Benchmark"),
+	TEXT("Inventory.Simulation.Benchmark [NumInventories] [CommandsPerInventory] - times the bulk inventory commands single threaded and in parallel."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		int32 NumInventories = 512;
+		int32 CommandsPerInventory = 256;
+		if (Args.Num() > 0) {
+			FDefaultValueHelper::ParseInt(Args[0], NumInventories);
+		}
+		if (Args.Num() > 1) {
+			FDefaultValueHelper::ParseInt(Args[1], CommandsPerInventory);
+		}
+		UCpp_InventorySimulationSubsystem::RunBenchmark(FMath::Max(NumInventories, 1), FMath::Max(CommandsPerInventory, 1));
+	}));
+
+void UCpp_InventorySimulationSubsystem::QueueAdd(UCpp_AC_Inventory* Inventory, const FItemData& ItemData, const int32 Amount) {
+	if (Inventory && Amount > 0) {
+		FindOrAddQueue(Inventory).Commands.Add({EInventoryCommandType::Add, &ItemData, Amount});
+	}
+}
+
+void UCpp_InventorySimulationSubsystem::QueueRemove(UCpp_AC_Inventory* Inventory, const FItemData& ItemData, const int32 Amount) {
+	if (Inventory && Amount > 0) {
+		FindOrAddQueue(Inventory).Commands.Add({EInventoryCommandType::Remove, &ItemData, Amount});
+	}
+}
+
+FInventoryCommandQueue& UCpp_InventorySimulationSubsystem::FindOrAddQueue(UCpp_AC_Inventory* Inventory) {
+	// One queue per inventory, that is what makes it safe to hand every queue to a different worker
+	if (const int32* QueueIndex = QueueIndices.Find(Inventory)) {
+		return Queues[*QueueIndex];
+	}
+	QueueIndices.Add(Inventory, Queues.Num());
+	FInventoryCommandQueue& Queue = Queues.AddDefaulted_GetRef();
+	Queue.Inventory = Inventory;
+	return Queue;
+}
+
+void UCpp_InventorySimulationSubsystem::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	FlushCommands();
+}
+
+void UCpp_InventorySimulationSubsystem::FlushCommands() {
+	// Update listeners can queue more commands while the results are applied, those run in another pass.
+	// A listener that keeps queueing in response to its own updates is left for the next tick instead of looping here.
+	constexpr int32 MaxPasses = 4;
+	for (int32 Pass = 0; Pass < MaxPasses && !Queues.IsEmpty(); ++Pass) {
+		// Taken out first, new commands go into fresh queues instead of the ones being walked
+		TArray<FInventoryCommandQueue> QueuesToExecute = MoveTemp(Queues);
+		QueueIndices.Reset();
+
+		// Inventories destroyed since their commands were queued are dropped before any worker starts
+		QueuesToExecute.RemoveAllSwap([](const FInventoryCommandQueue& Queue) {
+			return !Queue.Inventory.IsValid();
+		});
+		ExecuteQueues(QueuesToExecute, CVarInventorySimulationParallel.GetValueOnGameThread());
+	}
+}
+
+void UCpp_InventorySimulationSubsystem::ExecuteQueues(TArrayView<FInventoryCommandQueue> InQueues, const bool bParallel) {
+	check(IsInGameThread());
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_InventorySimulationExecute);
+		// Unbalanced as some inventories get far more commands than others
+		ParallelFor(InQueues.Num(), [InQueues](const int32 QueueIndex) {
+			FInventoryCommandQueue& Queue = InQueues[QueueIndex];
+			Queue.Inventory->ExecuteCommands(Queue);
+		}, bParallel ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InventorySimulationApply);
+	int32 NumCommands = 0;
+	for (FInventoryCommandQueue& Queue : InQueues) {
+		Queue.Inventory->ApplyCommandResults(Queue);
+		NumCommands += Queue.Commands.Num();
+	}
+	INC_DWORD_STAT_BY(STAT_InventorySimulationInventories, InQueues.Num());
+	INC_DWORD_STAT_BY(STAT_InventorySimulationCommands, NumCommands);
+}
+
+TStatId UCpp_InventorySimulationSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCpp_InventorySimulationSubsystem, STATGROUP_Inventory);
+}
+
+void UCpp_InventorySimulationSubsystem::RunBenchmark(const int32 NumInventories, const int32 CommandsPerInventory) {
+	// A handful of made up items, stackable and not, light and heavy
+	static TArray<FItemData> BenchmarkItems;
+	if (BenchmarkItems.IsEmpty()) {
+		for (int32 ItemIndex = 0; ItemIndex < 16; ++ItemIndex) {
+			FItemData& ItemData = BenchmarkItems.AddDefaulted_GetRef();
+			ItemData.ID = FName(TEXT("BenchmarkItem"), ItemIndex + 1);
+			ItemData.ItemType = static_cast<EItemType>(ItemIndex % NumItemTypes);
+			ItemData.ItemQuality = static_cast<EItemQuality>(ItemIndex % NumItemQualities);
+			ItemData.ItemNumericData.MaxStackSize = ItemIndex % 4 == 0 ? 1 : 20 * (ItemIndex % 4);
+			ItemData.ItemNumericData.Weight = 1 + ItemIndex % 5;
+			ItemData.ItemNumericData.bIsStackable = ItemData.ItemNumericData.MaxStackSize > 1;
+		}
+	}
+
+	auto BuildQueues = [NumInventories, CommandsPerInventory](TArray<FInventoryCommandQueue>& OutQueues) {
+		OutQueues.Reset(NumInventories);
+		for (int32 InventoryIndex = 0; InventoryIndex < NumInventories; ++InventoryIndex) {
+			UCpp_AC_Inventory* Inventory = NewObject<UCpp_AC_Inventory>(GetTransientPackage());
+			Inventory->SetSlotsCapacity(40);
+			Inventory->SetWeightCapacity(500.0f);
+
+			FInventoryCommandQueue& Queue = OutQueues.AddDefaulted_GetRef();
+			Queue.Inventory = Inventory;
+			Queue.Commands.Reserve(CommandsPerInventory);
+			// Same seed for both runs, so both do exactly the same work
+			FRandomStream RandomStream(InventoryIndex);
+			for (int32 CommandIndex = 0; CommandIndex < CommandsPerInventory; ++CommandIndex) {
+				const EInventoryCommandType Type = RandomStream.FRand() < 0.7f ? EInventoryCommandType::Add : EInventoryCommandType::Remove;
+				Queue.Commands.Add({Type, &BenchmarkItems[RandomStream.RandHelper(BenchmarkItems.Num())], RandomStream.RandRange(1, 20)});
+			}
+		}
+	};
+
+	TArray<FInventoryCommandQueue> BenchmarkQueues;
+
+	BuildQueues(BenchmarkQueues);
+	const double SingleThreadStart = FPlatformTime::Seconds();
+	ExecuteQueues(BenchmarkQueues, false);
+	const double SingleThreadTime = FPlatformTime::Seconds() - SingleThreadStart;
+
+	BuildQueues(BenchmarkQueues);
+	const double ParallelStart = FPlatformTime::Seconds();
+	ExecuteQueues(BenchmarkQueues, true);
+	const double ParallelTime = FPlatformTime::Seconds() - ParallelStart;
+
+	UE_LOG(LogTemp, Display, TEXT("Inventory Simulation: %d inventories x %d commands, single threaded %.2f ms, parallel %.2f ms (%.2fx on %d workers)"),
+		NumInventories, CommandsPerInventory, SingleThreadTime * 1000.0, ParallelTime * 1000.0,
+		ParallelTime > 0.0 ? SingleThreadTime / ParallelTime : 0.0, FTaskGraphInterface::Get().GetNumWorkerThreads());
+}
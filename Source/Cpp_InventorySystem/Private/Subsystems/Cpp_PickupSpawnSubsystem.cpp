@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Cpp_PickupSpawnSubsystem.h"
+#include "World/Pickup.h"
+#include "ItemBase.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/AnyOf.h"
+#include "Algo/Count.h"
+#include "../Cpp_InventorySystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Spawn Queue"), STAT_PickupSpawnQueue, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Spawn Queue Depth"), STAT_PickupSpawnQueueDepth, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Spawned"), STAT_PickupsSpawned, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Initialized"), STAT_PickupsInitialized, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<bool> CVarPickupSpawnQueueEnabled(
+	TEXT("Inventory.PickupSpawn.Enabled"),
+	true,
+	TEXT("Spawn and initialize pickups through the time sliced queue. When off every pickup is spawned and initialized right away."));
+
+static TAutoConsoleVariable<float> CVarPickupSpawnBudgetMs(
+	TEXT("Inventory.PickupSpawn.BudgetMs"),
+	1.0f,
+	TEXT("Milliseconds per frame spent spawning and initializing queued pickups, at least one is handled per frame."));
+
+static TAutoConsoleVariable<float> CVarPickupSpawnResortInterval(
+	TEXT("Inventory.PickupSpawn.ResortInterval"),
+	0.5f,
+	TEXT("Seconds between sorting the queue by distance to the players again while it isn't empty, players move while it drains."));
+
+static TAutoConsoleVariable<float> CVarPickupSpawnImmediateRadius(
+	TEXT("Inventory.PickupSpawn.ImmediateRadius"),
+	500.0f,
+	TEXT("Placed pickups this close to a player are initialized at once outside the budget, keep it above the interaction trace length."));
+
+bool UCpp_PickupSpawnSubsystem::IsQueueEnabled() {
+	return CVarPickupSpawnQueueEnabled.GetValueOnGameThread();
+}
+
+void UCpp_PickupSpawnSubsystem::SpawnDrop(UWorld* World, UItemBase* Item, const int32 Quantity, const FTransform& Transform, AActor* Owner) {
+	if (!World || !Item) {
+		return;
+	}
+	UCpp_PickupSpawnSubsystem* SpawnQueue = World->GetSubsystem<UCpp_PickupSpawnSubsystem>();
+	if (!SpawnQueue || !IsQueueEnabled()) {
+		SpawnDropNow(World, Item, Quantity, Transform, Owner);
+		return;
+	}
+
+	FPendingPickupWork& Work = SpawnQueue->PendingWork.AddDefaulted_GetRef();
+	Work.Item = Item;
+	Work.Quantity = Quantity;
+	Work.Transform = Transform;
+	Work.Owner = Owner;
+	SpawnQueue->bNeedsSort = true;
+}
+
+void UCpp_PickupSpawnSubsystem::InitializePlacedPickup(APickup* Pickup) {
+	if (!Pickup) {
+		return;
+	}
+	const UWorld* World = Pickup->GetWorld();
+	UCpp_PickupSpawnSubsystem* SpawnQueue = World ? World->GetSubsystem<UCpp_PickupSpawnSubsystem>() : nullptr;
+	if (!SpawnQueue || !IsQueueEnabled()) {
+		InitializePickupNow(Pickup);
+		return;
+	}
+
+	FPendingPickupWork& Work = SpawnQueue->PendingWork.AddDefaulted_GetRef();
+	Work.Pickup = Pickup;
+	Work.Transform = Pickup->GetActorTransform();
+	SpawnQueue->bNeedsSort = true;
+}
+
+void UCpp_PickupSpawnSubsystem::SpawnDropNow(UWorld* World, UItemBase* Item, const int32 Quantity, const FTransform& Transform, AActor* Owner) {
+	FActorSpawnParameters SpawnParams; // Struct that defines how the actor should be spawned
+	SpawnParams.Owner = Owner;
+	SpawnParams.bNoFail = true; // always spawn the actor
+	// Adjust the spawn location to avoid collision but always spawn the actor
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	APickup* Pickup = World->SpawnActor<APickup>(APickup::StaticClass(), Transform, SpawnParams);
+	Pickup->InitializeDrop(Item, Quantity);
+	INC_DWORD_STAT(STAT_PickupsSpawned);
+}
+
+void UCpp_PickupSpawnSubsystem::InitializePickupNow(APickup* Pickup) {
+	// A pickup that was focused while queued has been initialized already
+	if (!Pickup->GetItemData()) {
+		Pickup->EnsureInitialized();
+		INC_DWORD_STAT(STAT_PickupsInitialized);
+	}
+}
+
+void UCpp_PickupSpawnSubsystem::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_PickupSpawnQueue);
+
+	UWorld* World = GetWorld();
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	GatherPlayerLocations(PlayerLocations);
+
+	const double Now = World->GetTimeSeconds();
+	if (bNeedsSort || Now - LastSortTime >= CVarPickupSpawnResortInterval.GetValueOnGameThread()) {
+		SortByDistanceToPlayers(PlayerLocations);
+		bNeedsSort = false;
+		LastSortTime = Now;
+	}
+
+	InitializePickupsNearPlayers(PlayerLocations);
+	if (PendingWork.IsEmpty()) {
+		SET_DWORD_STAT(STAT_PickupSpawnQueueDepth, 0);
+		return;
+	}
+
+	const double Deadline = FPlatformTime::Seconds() + FMath::Max(CVarPickupSpawnBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+	do {
+		// Spawning can queue more work (BeginPlay of the new pickup), so the entry is taken out first
+		FPendingPickupWork Work = PendingWork.Pop(false);
+		if (Work.Item) {
+			SpawnDropNow(World, Work.Item, Work.Quantity, Work.Transform, Work.Owner.Get());
+		}
+		else if (APickup* Pickup = Work.Pickup.Get()) {
+			InitializePickupNow(Pickup);
+		}
+	} while (!PendingWork.IsEmpty() && FPlatformTime::Seconds() < Deadline);
+
+	SET_DWORD_STAT(STAT_PickupSpawnQueueDepth, PendingWork.Num());
+}
+
+void UCpp_PickupSpawnSubsystem::GatherPlayerLocations(TArray<FVector, TInlineAllocator<4>>& OutPlayerLocations) const {
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+		if (const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr) {
+			OutPlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+}
+
+void UCpp_PickupSpawnSubsystem::InitializePickupsNearPlayers(TConstArrayView<FVector> PlayerLocations) {
+	const double ImmediateRadiusSquared = FMath::Square(CVarPickupSpawnImmediateRadius.GetValueOnGameThread());
+	if (PlayerLocations.IsEmpty() || ImmediateRadiusSquared <= 0.0) {
+		return;
+	}
+
+	// Closest entries are last, so only the tail can be in range. Drops are left to the budget, they are spawned
+	// where a player stands and would all count as near. Players that moved since the sort are caught by the next one.
+	while (!PendingWork.IsEmpty() && !PendingWork.Last().Item) {
+		const FVector Location = PendingWork.Last().Transform.GetLocation();
+		const bool bNearPlayer = Algo::AnyOf(PlayerLocations, [&Location, ImmediateRadiusSquared](const FVector& PlayerLocation) {
+			return FVector::DistSquared(Location, PlayerLocation) <= ImmediateRadiusSquared;
+		});
+		if (!bNearPlayer) {
+			break;
+		}
+		const FPendingPickupWork Work = PendingWork.Pop(false);
+		if (APickup* Pickup = Work.Pickup.Get()) {
+			InitializePickupNow(Pickup);
+		}
+	}
+}
+
+void UCpp_PickupSpawnSubsystem::SortByDistanceToPlayers(TConstArrayView<FVector> PlayerLocations) {
+	// Without a player (still loading in) the order they were queued in is as good as any
+	if (PlayerLocations.IsEmpty()) {
+		return;
+	}
+
+	for (FPendingPickupWork& Work : PendingWork) {
+		const FVector Location = Work.Transform.GetLocation();
+		Work.DistanceSquared = TNumericLimits<double>::Max();
+		for (const FVector& PlayerLocation : PlayerLocations) {
+			Work.DistanceSquared = FMath::Min(Work.DistanceSquared, FVector::DistSquared(Location, PlayerLocation));
+		}
+	}
+	PendingWork.Sort([](const FPendingPickupWork& A, const FPendingPickupWork& B) {
+		return A.DistanceSquared > B.DistanceSquared;
+	});
+}
+
+void UCpp_PickupSpawnSubsystem::Deinitialize() {
+	const int32 NumDrops = Algo::CountIf(PendingWork, [](const FPendingPickupWork& Work) {
+		return Work.Item != nullptr;
+	});
+	if (NumDrops > 0) {
+		UE_LOG(LogTemp, Warning, TEXT("World torn down with %d dropped pickups still queued, their items are lost!"), NumDrops);
+	}
+	PendingWork.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UCpp_PickupSpawnSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCpp_PickupSpawnSubsystem, STATGROUP_Inventory);
+}
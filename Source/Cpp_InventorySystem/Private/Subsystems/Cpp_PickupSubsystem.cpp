@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Cpp_PickupSubsystem.h"
+#include "World/Pickup.h"
+#include "ItemBase.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "../Cpp_InventorySystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Merge Pass"), STAT_PickupMergePass, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Merges"), STAT_PickupMerges, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("World Pickups"), STAT_WorldPickups, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<bool> CVarPickupMergeEnabled(
+	TEXT("Inventory.PickupMerge.Enabled"),
+	true,
+	TEXT("Merge dropped pickups into nearby pickups of the same stackable item."));
+
+static TAutoConsoleVariable<float> CVarPickupMergeRadius(
+	TEXT("Inventory.PickupMerge.Radius"),
+	150.0f,
+	TEXT("Distance in cm a dropped pickup is merged over. Also the grid cell size, changes to it apply to the next world."));
+
+static TAutoConsoleVariable<float> CVarPickupMergeDelay(
+	TEXT("Inventory.PickupMerge.Delay"),
+	1.0f,
+	TEXT("Seconds a dropped pickup gets to land before it is merged."));
+
+static TAutoConsoleVariable<float> CVarPickupMergeBudgetMs(
+	TEXT("Inventory.PickupMerge.BudgetMs"),
+	0.2f,
+	TEXT("Milliseconds per frame spent merging queued pickups, at least one pickup is handled per frame."));
+
+void UCpp_PickupSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+	Super::Initialize(Collection);
+
+	// A query only ever has to look at the 3x3 cells around a pickup
+	Grid = TCpp_SpatialHashGrid<APickup*>(CVarPickupMergeRadius.GetValueOnGameThread());
+}
+
+void UCpp_PickupSubsystem::RegisterPickup(APickup* Pickup, const bool bMergeNearby) {
+	if (!Pickup) {
+		return;
+	}
+
+	if (FIntPoint* Cell = Pickups.Find(Pickup)) {
+		*Cell = Grid.Move(Pickup, *Cell, Pickup->GetActorLocation());
+	}
+	else {
+		Pickups.Add(Pickup, Grid.Add(Pickup, Pickup->GetActorLocation()));
+		INC_DWORD_STAT(STAT_WorldPickups);
+	}
+
+	if (bMergeNearby && CVarPickupMergeEnabled.GetValueOnGameThread()) {
+		const float Delay = FMath::Max(CVarPickupMergeDelay.GetValueOnGameThread(), 0.0f);
+		PendingMerges.Add({Pickup, GetWorld()->GetTimeSeconds() + Delay});
+	}
+}
+
+void UCpp_PickupSubsystem::UnregisterPickup(APickup* Pickup) {
+	FIntPoint Cell;
+	if (Pickups.RemoveAndCopyValue(Pickup, Cell)) {
+		Grid.Remove(Pickup, Cell);
+		DEC_DWORD_STAT(STAT_WorldPickups);
+	}
+	// Its queue entry is left behind, the weak pointer goes stale and the entry is skipped
+}
+
+void UCpp_PickupSubsystem::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	if (!CVarPickupMergeEnabled.GetValueOnGameThread()) {
+		PendingMerges.Reset();
+		PendingMergesHead = 0;
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PickupMergePass);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double Deadline = FPlatformTime::Seconds() + FMath::Max(CVarPickupMergeBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+	int32 NumMerges = 0;
+	while (PendingMergesHead < PendingMerges.Num() && PendingMerges[PendingMergesHead].ReadyTime <= Now) {
+		// Merging can queue the pickup again, which may reallocate the queue
+		APickup* Pickup = PendingMerges[PendingMergesHead++].Pickup.Get();
+		if (Pickup && Pickups.Contains(Pickup) && MergeIntoNearbyStack(Pickup)) {
+			++NumMerges;
+		}
+		if (FPlatformTime::Seconds() >= Deadline) {
+			break;
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_PickupMerges, NumMerges);
+
+	if (PendingMergesHead == PendingMerges.Num()) {
+		PendingMerges.Reset();
+		PendingMergesHead = 0;
+	}
+	else if (PendingMergesHead > PendingMerges.Num() / 2) {
+		PendingMerges.RemoveAt(0, PendingMergesHead, false);
+		PendingMergesHead = 0;
+	}
+}
+
+bool UCpp_PickupSubsystem::MergeIntoNearbyStack(APickup* Pickup) {
+	const UItemBase* Item = Pickup->GetItemData();
+	if (Pickup->IsPendingKillPending() || !Item || !Item->ItemNumericData.bIsStackable || Item->IsFullItemStack()) {
+		return false;
+	}
+
+	// The pickup has landed by now, put it in the cell it ended up in
+	const FVector Location = Pickup->GetActorLocation();
+	FIntPoint& Cell = Pickups.FindChecked(Pickup);
+	Cell = Grid.Move(Pickup, Cell, Location);
+
+	// Filling the fullest stack first leaves the fewest partial stacks behind.
+	// Cells of the other pickups can be stale if they moved after their last refresh, that only ever misses a merge.
+	const float Radius = CVarPickupMergeRadius.GetValueOnGameThread();
+	APickup* Target = nullptr;
+	int32 TargetQuantity = 0;
+	Grid.ForEachNear(Location, Radius, [&](APickup* Other) {
+		const UItemBase* OtherItem = Other->GetItemData();
+		if (Other == Pickup || Other->IsPendingKillPending() || !OtherItem || OtherItem->ID != Item->ID) {
+			return;
+		}
+		if (OtherItem->IsFullItemStack() || OtherItem->Quantity <= TargetQuantity) {
+			return;
+		}
+		if (FVector::DistSquared(Other->GetActorLocation(), Location) <= FMath::Square(Radius)) {
+			Target = Other;
+			TargetQuantity = OtherItem->Quantity;
+		}
+	});
+
+	if (!Target || Target->AbsorbPickup(Pickup) == 0) {
+		return false;
+	}
+	// The target ran full before taking everything, what is left may still fit into another stack
+	if (!Pickup->IsPendingKillPending()) {
+		PendingMerges.Add({Pickup, GetWorld()->GetTimeSeconds()});
+	}
+	return true;
+}
+
+void UCpp_PickupSubsystem::Deinitialize() {
+	DEC_DWORD_STAT_BY(STAT_WorldPickups, Pickups.Num());
+	Grid.Reset();
+	Pickups.Reset();
+	PendingMerges.Reset();
+	PendingMergesHead = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UCpp_PickupSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCpp_PickupSubsystem, STATGROUP_Inventory);
+}
@@ -0,0 +1,253 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Cpp_SignificanceSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Scalability.h"
+#include "../Cpp_InventorySystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_SignificanceUpdate, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Bucket Changes"), STAT_SignificanceBucketChanges, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Near"), STAT_SignificanceNear, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Mid"), STAT_SignificanceMid, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Far"), STAT_SignificanceFar, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Culled"), STAT_SignificanceCulled, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<bool> CVarSignificanceEnabled(
+	TEXT("Inventory.Significance.Enabled"),
+	true,
+	TEXT("Lower the physics, collision and render cost of pickups and interactables far from the players.\n")
+	TEXT("Turning it off brings every item back to full fidelity."));
+
+static TAutoConsoleVariable<float> CVarSignificanceNearDistance(
+	TEXT("Inventory.Significance.NearDistance"),
+	1500.0f,
+	TEXT("Distance in cm up to which items keep their physics, collision and shadows."));
+
+static TAutoConsoleVariable<float> CVarSignificanceFarDistance(
+	TEXT("Inventory.Significance.FarDistance"),
+	5000.0f,
+	TEXT("Distance in cm from which items lose their collision."));
+
+static TAutoConsoleVariable<float> CVarSignificanceCullDistance(
+	TEXT("Inventory.Significance.CullDistance"),
+	0.0f,
+	TEXT("Distance in cm from which items aren't drawn at all, 0 always draws them."));
+
+static TAutoConsoleVariable<float> CVarSignificanceBehindViewScale(
+	TEXT("Inventory.Significance.BehindViewScale"),
+	0.5f,
+	TEXT("Scales the distances for items behind every player's view, below 1 lowers their detail sooner."));
+
+static TAutoConsoleVariable<float> CVarSignificanceHysteresis(
+	TEXT("Inventory.Significance.Hysteresis"),
+	0.1f,
+	TEXT("Fraction of a distance an item has to move past it to change bucket."));
+
+static TAutoConsoleVariable<int32> CVarSignificanceUpdatesPerFrame(
+	TEXT("Inventory.Significance.UpdatesPerFrame"),
+	256,
+	TEXT("Items whose bucket is recalculated per frame, round robin."));
+
+namespace {
+	// Distances per sg.ViewDistanceQuality level, Low to Cinematic
+	constexpr float ViewDistanceQualityScales[] = {0.5f, 0.75f, 1.0f, 1.25f, 1.5f};
+}
+
+void UCpp_SignificanceSubsystem::RegisterItem(AActor* Owner, UPrimitiveComponent* Primitive) {
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	if (UCpp_SignificanceSubsystem* Significance = World ? World->GetSubsystem<UCpp_SignificanceSubsystem>() : nullptr) {
+		Significance->AddItem(Owner, Primitive);
+	}
+}
+
+void UCpp_SignificanceSubsystem::UnregisterItem(AActor* Owner) {
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	if (UCpp_SignificanceSubsystem* Significance = World ? World->GetSubsystem<UCpp_SignificanceSubsystem>() : nullptr) {
+		Significance->RemoveItem(Owner);
+	}
+}
+
+void UCpp_SignificanceSubsystem::AddItem(AActor* Owner, UPrimitiveComponent* Primitive) {
+	if (!Owner || !Primitive || ItemIndices.Contains(Owner)) {
+		return;
+	}
+
+	FSignificanceItem& Item = Items.AddDefaulted_GetRef();
+	Item.Owner = Owner;
+	Item.Primitive = Primitive;
+	Item.CollisionEnabled = Primitive->GetCollisionEnabled();
+	Item.bSimulatePhysics = Primitive->BodyInstance.bSimulatePhysics;
+	Item.bCastShadow = Primitive->CastShadow;
+	ItemIndices.Add(Owner, Items.Num() - 1);
+	++BucketPopulations[static_cast<int32>(ESignificanceBucket::Near)];
+}
+
+void UCpp_SignificanceSubsystem::RemoveItem(AActor* Owner) {
+	int32 Index;
+	if (!ItemIndices.RemoveAndCopyValue(Owner, Index)) {
+		return;
+	}
+
+	--BucketPopulations[static_cast<int32>(Items[Index].Bucket)];
+	Items.RemoveAtSwap(Index, 1, false);
+	if (Items.IsValidIndex(Index)) {
+		ItemIndices[Items[Index].Owner] = Index;
+	}
+}
+
+void UCpp_SignificanceSubsystem::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_SignificanceUpdate);
+
+	int32 NumChanges = 0;
+	if (!CVarSignificanceEnabled.GetValueOnGameThread()) {
+		// Everything back to full fidelity once, afterwards there is nothing left to do
+		if (BucketPopulations[static_cast<int32>(ESignificanceBucket::Near)] != Items.Num()) {
+			for (FSignificanceItem& Item : Items) {
+				const ESignificanceBucket OldBucket = Item.Bucket;
+				if (OldBucket != ESignificanceBucket::Near && Item.Primitive.IsValid() && ApplyBucket(Item, ESignificanceBucket::Near)) {
+					--BucketPopulations[static_cast<int32>(OldBucket)];
+					++BucketPopulations[static_cast<int32>(ESignificanceBucket::Near)];
+					++NumChanges;
+				}
+			}
+		}
+	}
+	else {
+		TArray<FViewPoint, TInlineAllocator<4>> ViewPoints;
+		GatherViewPoints(ViewPoints);
+		if (!ViewPoints.IsEmpty()) {
+			const int32 ViewDistanceQuality = FMath::Clamp(Scalability::GetQualityLevels().ViewDistanceQuality, 0, static_cast<int32>(UE_ARRAY_COUNT(ViewDistanceQualityScales)) - 1);
+			const float DistanceScale = ViewDistanceQualityScales[ViewDistanceQuality];
+
+			const int32 NumUpdates = FMath::Min(FMath::Max(CVarSignificanceUpdatesPerFrame.GetValueOnGameThread(), 1), Items.Num());
+			for (int32 Update = 0; Update < NumUpdates; ++Update) {
+				if (NextItem >= Items.Num()) {
+					NextItem = 0;
+				}
+				FSignificanceItem& Item = Items[NextItem++];
+				if (!Item.Primitive.IsValid()) {
+					continue;
+				}
+
+				const ESignificanceBucket OldBucket = Item.Bucket;
+				const ESignificanceBucket NewBucket = CalculateBucket(Item, ViewPoints, DistanceScale);
+				if (NewBucket != OldBucket && ApplyBucket(Item, NewBucket)) {
+					--BucketPopulations[static_cast<int32>(OldBucket)];
+					++BucketPopulations[static_cast<int32>(NewBucket)];
+					++NumChanges;
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_SignificanceBucketChanges, NumChanges);
+	SET_DWORD_STAT(STAT_SignificanceNear, BucketPopulations[static_cast<int32>(ESignificanceBucket::Near)]);
+	SET_DWORD_STAT(STAT_SignificanceMid, BucketPopulations[static_cast<int32>(ESignificanceBucket::Mid)]);
+	SET_DWORD_STAT(STAT_SignificanceFar, BucketPopulations[static_cast<int32>(ESignificanceBucket::Far)]);
+	SET_DWORD_STAT(STAT_SignificanceCulled, BucketPopulations[static_cast<int32>(ESignificanceBucket::Culled)]);
+}
+
+void UCpp_SignificanceSubsystem::GatherViewPoints(TArray<FViewPoint, TInlineAllocator<4>>& OutViewPoints) const {
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController || !PlayerController->GetPawnOrSpectator()) {
+			continue;
+		}
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		OutViewPoints.Add({ViewLocation, ViewRotation.Vector()});
+	}
+}
+
+ESignificanceBucket UCpp_SignificanceSubsystem::CalculateBucket(const FSignificanceItem& Item, TConstArrayView<FViewPoint> ViewPoints, const float DistanceScale) {
+	const FVector Location = Item.Owner->GetActorLocation();
+	double Distance = TNumericLimits<double>::Max();
+	bool bInFrontOfView = false;
+	for (const FViewPoint& ViewPoint : ViewPoints) {
+		const FVector ToItem = Location - ViewPoint.Location;
+		Distance = FMath::Min(Distance, ToItem.Size());
+		bInFrontOfView |= (ToItem | ViewPoint.Direction) >= 0.0;
+	}
+
+	const double Scale = DistanceScale * (bInFrontOfView ? 1.0f : FMath::Max(CVarSignificanceBehindViewScale.GetValueOnGameThread(), 0.0f));
+	const double Hysteresis = FMath::Clamp(CVarSignificanceHysteresis.GetValueOnGameThread(), 0.0f, 0.5f);
+	// A threshold is pushed away from the bucket the item is in, so it has to move past it by the hysteresis to leave
+	auto IsBeyond = [&](const float Threshold, const ESignificanceBucket OuterBucket) {
+		const double Boundary = Threshold * Scale * (Item.Bucket < OuterBucket ? 1.0 + Hysteresis : 1.0 - Hysteresis);
+		return Distance >= Boundary;
+	};
+
+	const float CullDistance = CVarSignificanceCullDistance.GetValueOnGameThread();
+	if (CullDistance > 0.0f && IsBeyond(CullDistance, ESignificanceBucket::Culled)) {
+		return ESignificanceBucket::Culled;
+	}
+	if (IsBeyond(CVarSignificanceFarDistance.GetValueOnGameThread(), ESignificanceBucket::Far)) {
+		return ESignificanceBucket::Far;
+	}
+	if (IsBeyond(CVarSignificanceNearDistance.GetValueOnGameThread(), ESignificanceBucket::Mid)) {
+		return ESignificanceBucket::Mid;
+	}
+	return ESignificanceBucket::Near;
+}
+
+bool UCpp_SignificanceSubsystem::ApplyBucket(FSignificanceItem& Item, const ESignificanceBucket NewBucket) {
+	UPrimitiveComponent* Primitive = Item.Primitive.Get();
+	const bool bNear = NewBucket == ESignificanceBucket::Near;
+
+	// A falling or rolling item would freeze in mid air, it is left alone until it came to rest
+	if (!bNear && Primitive->IsSimulatingPhysics()) {
+		if (Primitive->RigidBodyIsAwake()) {
+			return false;
+		}
+		Primitive->SetSimulatePhysics(false);
+	}
+
+	ECollisionEnabled::Type CollisionEnabled = Item.CollisionEnabled;
+	if (NewBucket == ESignificanceBucket::Mid) {
+		// Still found by the interaction trace, nothing collides with it anymore
+		CollisionEnabled = Item.CollisionEnabled == ECollisionEnabled::NoCollision ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryOnly;
+	}
+	else if (!bNear) {
+		CollisionEnabled = ECollisionEnabled::NoCollision;
+	}
+	if (Primitive->GetCollisionEnabled() != CollisionEnabled) {
+		Primitive->SetCollisionEnabled(CollisionEnabled);
+	}
+
+	// Physics needs the collision back first
+	if (bNear && Item.bSimulatePhysics && !Primitive->IsSimulatingPhysics()) {
+		Primitive->SetSimulatePhysics(true);
+	}
+
+	const bool bCastShadow = bNear && Item.bCastShadow;
+	if (Primitive->CastShadow != bCastShadow) {
+		Primitive->SetCastShadow(bCastShadow);
+	}
+	const bool bHidden = NewBucket == ESignificanceBucket::Culled;
+	if (Primitive->bHiddenInGame != bHidden) {
+		Primitive->SetHiddenInGame(bHidden);
+	}
+
+	Item.Bucket = NewBucket;
+	return true;
+}
+
+void UCpp_SignificanceSubsystem::Deinitialize() {
+	Items.Reset();
+	ItemIndices.Reset();
+	NextItem = 0;
+	FMemory::Memzero(BucketPopulations);
+
+	Super::Deinitialize();
+}
+
+TStatId UCpp_SignificanceSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCpp_SignificanceSubsystem, STATGROUP_Inventory);
+}
@@ -4,6 +4,11 @@
 #include "UI/Cpp_InventoryHUD.h"
 #include "UI/Cpp_WGT_MainMenu.h"
 #include "UI/Interaction/Cpp_WGT_Interaction.h"
+#include "UI/Inventory/Cpp_WGT_DragItem.h"
+#include "UI/Inventory/Cpp_ItemDragDropOperation.h"
+#include "../Cpp_InventorySystemCharacter.h"
+#include "TimerManager.h"
+#include "Misc/App.h"
 
 ACpp_InventoryHUD::ACpp_InventoryHUD() {
 
@@ -12,39 +17,95 @@ ACpp_InventoryHUD::ACpp_InventoryHUD() {
 void ACpp_InventoryHUD::BeginPlay() {
 	Super::BeginPlay();
 
-	if(MainMenuClass) {
+	// Nothing is created up front, see GetOrCreateMainMenu / GetOrCreateInteractionWidget / GetOrCreateCrosshair
+	if (bPrewarmWidgets) {
+		GetWorldTimerManager().SetTimerForNextTick(this, &ACpp_InventoryHUD::PrewarmNextWidget);
+	}
+}
+
+UCpp_WGT_MainMenu* ACpp_InventoryHUD::GetOrCreateMainMenu() {
+	if(!MainMenuWidget && MainMenuClass) {
 		// Create the main menu widget based on the class
 		MainMenuWidget = CreateWidget<UCpp_WGT_MainMenu>(GetWorld(), MainMenuClass);
 		MainMenuWidget->AddToViewport(5);
 		MainMenuWidget->SetVisibility(ESlateVisibility::Collapsed);
 	}
+	return MainMenuWidget;
+}
 
-	if(InteractionClass) {
-		// Create the main menu widget based on the class
+UCpp_WGT_Interaction* ACpp_InventoryHUD::GetOrCreateInteractionWidget() {
+	if(!InteractionWidget && InteractionClass) {
+		// Create the interaction widget based on the class
 		InteractionWidget = CreateWidget<UCpp_WGT_Interaction>(GetWorld(), InteractionClass);
 		InteractionWidget->AddToViewport(-1);
 		InteractionWidget->SetVisibility(ESlateVisibility::Collapsed);
 	}
+	return InteractionWidget;
+}
 
-	if (CrosshairClass) {
+UUserWidget* ACpp_InventoryHUD::GetOrCreateCrosshair() {
+	if (!CrosshairWidget && CrosshairClass) {
 		// Create the crosshair
 		CrosshairWidget = CreateWidget<UUserWidget>(GetWorld(), CrosshairClass);
 		CrosshairWidget->AddToViewport(10);
 		CrosshairWidget->SetVisibility(ESlateVisibility::Collapsed);
 	}
+	return CrosshairWidget;
+}
 
+void ACpp_InventoryHUD::PrewarmNextWidget() {
+	// Spectators and pawns without an inventory never open these widgets
+	const APawn* OwningPawn = GetOwningPawn();
+	if (OwningPawn && !OwningPawn->IsA<ACpp_InventorySystemCharacter>()) {
+		return;
+	}
+
+	// One widget per frame, and only on frames that aren't already slow
+	if (OwningPawn && FApp::GetDeltaTime() <= PrewarmMaxFrameTime) {
+		switch (PrewarmStep++) {
+			case 0:
+				GetOrCreateInteractionWidget();
+				break;
+			case 1:
+				GetOrCreateCrosshair();
+				break;
+			case 2:
+				// Released like a closed menu if the player doesn't open it in time, it would stay in memory otherwise
+				if (GetOrCreateMainMenu() && !bIsMenuVisible && MainMenuReleaseDelay > 0.0f && !GetWorldTimerManager().IsTimerActive(MainMenuReleaseTimer)) {
+					GetWorldTimerManager().SetTimer(MainMenuReleaseTimer, this, &ACpp_InventoryHUD::ReleaseMainMenu, MainMenuReleaseDelay, false);
+				}
+				break;
+			default:
+				return;
+		}
+	}
+	GetWorldTimerManager().SetTimerForNextTick(this, &ACpp_InventoryHUD::PrewarmNextWidget);
+}
+
+void ACpp_InventoryHUD::ReleaseMainMenu() {
+	if (MainMenuWidget && !bIsMenuVisible) {
+		MainMenuWidget->RemoveFromParent();
+		MainMenuWidget = nullptr;
+	}
 }
 
 void ACpp_InventoryHUD::DisplayMenu() {
-	if(MainMenuWidget) {
+	GetWorldTimerManager().ClearTimer(MainMenuReleaseTimer);
+	if(GetOrCreateMainMenu()) {
 		bIsMenuVisible = true;
 		MainMenuWidget->SetVisibility(ESlateVisibility::Visible);
+		MainMenuWidget->SetMenuOpen(true);
 	}
 }
 void ACpp_InventoryHUD::HideMenu() {
 	if(MainMenuWidget) {
 		bIsMenuVisible = false;
 		MainMenuWidget->SetVisibility(ESlateVisibility::Collapsed);
+		MainMenuWidget->SetMenuOpen(false);
+
+		if (MainMenuReleaseDelay > 0.0f) {
+			GetWorldTimerManager().SetTimer(MainMenuReleaseTimer, this, &ACpp_InventoryHUD::ReleaseMainMenu, MainMenuReleaseDelay, false);
+		}
 	}
 
 }
@@ -64,7 +125,7 @@ void ACpp_InventoryHUD::ToggleMenu() {
 }
 
 void ACpp_InventoryHUD::ShowCrosshair() {
-	if (CrosshairWidget) {
+	if (GetOrCreateCrosshair()) {
 		CrosshairWidget->SetVisibility(ESlateVisibility::Visible);		
 	}
 }
@@ -75,7 +136,7 @@ void ACpp_InventoryHUD::HideCrosshair() {
 }
 
 void ACpp_InventoryHUD::ShowInteractionWidget() {
-	if(InteractionWidget) {
+	if(GetOrCreateInteractionWidget()) {
 		InteractionWidget->SetVisibility(ESlateVisibility::Visible);
 	}
 
@@ -87,11 +148,32 @@ void ACpp_InventoryHUD::HideInteractionWidget() {
 
 }
 void ACpp_InventoryHUD::UpdateInteractionWidget(const FInteractableData* InteractableData) {
-	if(InteractionWidget) {
+	if(GetOrCreateInteractionWidget()) {
 		if(InteractionWidget->GetVisibility() == ESlateVisibility::Collapsed) {
 			InteractionWidget->SetVisibility(ESlateVisibility::Visible);
 		}
 		InteractionWidget->UpdateWidget(InteractableData);
 	}
 }
+void ACpp_InventoryHUD::UpdateInteractionProgress(const float Progress) {
+	if(InteractionWidget) {
+		InteractionWidget->SetInteractionProgress(Progress);
+	}
+}
+
+UCpp_ItemDragDropOperation* ACpp_InventoryHUD::BeginItemDrag(const TSubclassOf<UCpp_WGT_DragItem> DragVisualClass, UItemBase* Item, const FLinearColor& BorderColor) {
+	if (!DragVisualClass || !Item) {
+		return nullptr;
+	}
 
+	if (!DragVisual || DragVisual->GetClass() != DragVisualClass) {
+		DragVisual = CreateWidget<UCpp_WGT_DragItem>(PlayerOwner, DragVisualClass);
+	}
+	DragVisual->SetDraggedItem(Item, BorderColor);
+
+	if (!DragOperation) {
+		DragOperation = NewObject<UCpp_ItemDragDropOperation>(this);
+	}
+	DragOperation->SetDraggedItem(Item, DragVisual);
+	return DragOperation;
+}
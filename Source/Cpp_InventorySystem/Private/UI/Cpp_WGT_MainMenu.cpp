@@ -1,9 +1,41 @@
 #include "UI/Cpp_WGT_MainMenu.h"
 #include "UI/Inventory/Cpp_ItemDragDropOperation.h"
+#include "UI/Inventory/Cpp_WGT_InventoryPanel.h"
 #include "../Cpp_InventorySystemCharacter.h"
+#include "Components/RetainerBox.h"
+#include "Components/InvalidationBox.h"
 
 void UCpp_WGT_MainMenu::NativeOnInitialized() {
 	Super::NativeOnInitialized();
+
+	if (IB_Inventory) {
+		IB_Inventory->SetCanCache(true);
+	}
+	if (WGT_InventoryPanel) {
+		WGT_InventoryPanel->SetOwningMenu(this);
+	}
+	// The HUD creates the menu collapsed
+	SetMenuOpen(false);
+}
+
+void UCpp_WGT_MainMenu::SetMenuOpen(const bool bOpen) {
+	if (RB_MenuCache) {
+		// Nothing is rendered into the retainer while the menu is closed
+		RB_MenuCache->SetRetainRendering(bOpen);
+	}
+	if (WGT_InventoryPanel) {
+		WGT_InventoryPanel->SetPanelActive(bOpen);
+	}
+	if (bOpen) {
+		NotifyContentChanged();
+	}
+}
+
+void UCpp_WGT_MainMenu::NotifyContentChanged() const {
+	// A retainer set to render on invalidation picks up the change by itself
+	if (RB_MenuCache && !RB_MenuCache->IsRenderOnInvalidation()) {
+		RB_MenuCache->RequestRender();
+	}
 }
 
 void UCpp_WGT_MainMenu::NativeConstruct() {
@@ -6,24 +6,39 @@
 #include "Components/ProgressBar.h"
 #include "Interfaces/InteractionInterface.h"
 
+// Function local, a file scope FText would be built before the localization system is up
+static const FText& GetPressText() {
+	static const FText PressText = NSLOCTEXT("InteractionWidget", "TXT_KeyPressText", "Press");
+	return PressText;
+}
+
+static FText FormatQuantity(const int32 Quantity) {
+	return FText::Format(NSLOCTEXT("InteractionWidget", "TXT_Quantity", "x{0}"), FText::AsNumber(Quantity, &Cpp_TextFormatting::GetIntegerOptions()));
+}
+
 void UCpp_WGT_Interaction::NativeOnInitialized() {
 	Super::NativeOnInitialized();
 
-	// Percentage Delegate is used for updating the progress bar
-	PB_Interaction->PercentDelegate.BindUFunction(this, "UpdateInteractionProgress");
+	NameText.Bind(TXT_Name);
+	ActionText.Bind(TXT_Action);
+	KeyPressText.Bind(TXT_KeyPressText);
+	QuantityText.Bind(TXT_Quantity);
 }
 
 void UCpp_WGT_Interaction::NativeConstruct() {
 	Super::NativeConstruct();
 
-	TXT_KeyPressText->SetText(FText::FromString("Press"));
+	KeyPressText.Set(GetPressText());
 	CurrentInteractionDuration = 0.0f;
+	// The bar has no binding, it only changes when SetInteractionProgress is pushed a new value
+	CurrentInteractionProgress = 0.0f;
+	PB_Interaction->SetPercent(CurrentInteractionProgress);
 }
 
 void UCpp_WGT_Interaction::UpdateWidget(const FInteractableData* InteractableData) {
 	switch(InteractableData->InteractableType) {
 		case EInteractableType::Pickup:
-			TXT_KeyPressText->SetText(FText::FromString("Press"));
+			KeyPressText.Set(GetPressText());
 			PB_Interaction->SetVisibility(ESlateVisibility::Collapsed);
 
 			// Shows or Hides the Quantity TextBlock based on the quantity of the item
@@ -31,7 +46,7 @@ void UCpp_WGT_Interaction::UpdateWidget(const FInteractableData* InteractableDat
 				TXT_Quantity->SetVisibility(ESlateVisibility::Collapsed);
 			}
 			else {
-				TXT_Quantity->SetText(FText::Format(NSLOCTEXT("InteractionWidget", "TXT_Quantity", "x{0}"), InteractableData->Quantity));
+				QuantityText.Set(InteractableData->Quantity, &FormatQuantity);
 				TXT_Quantity->SetVisibility(ESlateVisibility::Visible);
 			}
 			break;
@@ -46,15 +61,31 @@ void UCpp_WGT_Interaction::UpdateWidget(const FInteractableData* InteractableDat
 			break;
 	
 		case EInteractableType::Container:
+			// Looting takes a while, the bar a previous pickup collapsed has to come back and start from empty
+			KeyPressText.Set(GetPressText());
+			PB_Interaction->SetVisibility(ESlateVisibility::Visible);
+			SetInteractionProgress(0.0f);
+
+			// Quantity is the number of stacks inside, nothing to show while it is empty or not rolled yet
+			if(InteractableData->Quantity <= 0) {
+				TXT_Quantity->SetVisibility(ESlateVisibility::Collapsed);
+			}
+			else {
+				// Same format as pickups, the cached value text only reformats when the number changes
+				QuantityText.Set(InteractableData->Quantity, &FormatQuantity);
+				TXT_Quantity->SetVisibility(ESlateVisibility::Visible);
+			}
 			break;
 	}
 
-	TXT_Action->SetText(InteractableData->Action);
-	TXT_Name->SetText(InteractableData->Name);
+	ActionText.Set(InteractableData->Action);
+	NameText.Set(InteractableData->Name);
 }	
 
-float UCpp_WGT_Interaction::UpdateInteractionProgress() {
-
-	return 0.0f;
+void UCpp_WGT_Interaction::SetInteractionProgress(const float Progress) {
+	// Below what the bar can show, skipping these saves invalidating the widget for nothing
+	if (!FMath::IsNearlyEqual(Progress, CurrentInteractionProgress, 0.005f) || (Progress != CurrentInteractionProgress && (Progress == 0.0f || Progress == 1.0f))) {
+		CurrentInteractionProgress = Progress;
+		PB_Interaction->SetPercent(Progress);
+	}
 }
-
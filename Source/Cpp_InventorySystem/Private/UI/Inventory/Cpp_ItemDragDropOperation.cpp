@@ -2,4 +2,17 @@
 
 
 #include "UI/Inventory/Cpp_ItemDragDropOperation.h"
+#include "ItemBase.h"
+
+void UCpp_ItemDragDropOperation::SetDraggedItem(UItemBase* Item, UWidget* DragVisual) {
+	SourceItem = Item;
+	SourceInventory = Item->OwningInventory;
+
+	// Whatever the last drag left behind is reset as well
+	Payload = nullptr;
+	Tag.Reset();
+	Offset = FVector2D::ZeroVector;
+	DefaultDragVisual = DragVisual;
+	Pivot = EDragPivot::TopLeft; // Tells it to drag from the top left corner of the widget
+}
 
@@ -2,4 +2,21 @@
 
 
 #include "UI/Inventory/Cpp_WGT_DragItem.h"
+#include "Data/Cpp_ItemIconAtlas.h"
+#include "ItemBase.h"
+#include "Components/Border.h"
+#include "Components/Image.h"
+#include "Components/TextBlock.h"
+
+void UCpp_WGT_DragItem::NativeOnInitialized() {
+	Super::NativeOnInitialized();
+
+	QuantityText.Bind(TXT_Quantity);
+}
+
+void UCpp_WGT_DragItem::SetDraggedItem(const UItemBase* Item, const FLinearColor& BorderColor) {
+	UCpp_ItemIconSubsystem::SetItemIcon(IMG_Icon, Item);
+	Border_Item->SetBrushColor(BorderColor);
+	QuantityText.Set(Item->Quantity, [](const int32 Quantity) { return FText::AsNumber(Quantity, &Cpp_TextFormatting::GetIntegerOptions()); });
+}
 
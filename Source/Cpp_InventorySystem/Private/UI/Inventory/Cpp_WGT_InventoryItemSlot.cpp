@@ -8,17 +8,19 @@
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
 #include "ItemBase.h"
+#include "Components/Cpp_AC_Inventory.h"
+#include "Data/Cpp_ItemIconAtlas.h"
 #include "UI/Inventory/Cpp_WGT_DragItem.h"
-#include "UI/Inventory/Cpp_ItemDragDropOperation.h"
+#include "UI/Cpp_InventoryHUD.h"
+#include "GameFramework/PlayerController.h"
 
 
 void UCpp_WGT_InventoryItemSlot::NativeOnInitialized() {
 	Super::NativeOnInitialized();
 	
 	if (ToolTipClass) {
-		UCpp_WGT_InventoryToolTip* ToolTip = CreateWidget<UCpp_WGT_InventoryToolTip>(this, ToolTipClass);
-		ToolTip->InventorySlotBeingHovered = this;
-		SetToolTip(ToolTip);
+		ItemToolTip = CreateWidget<UCpp_WGT_InventoryToolTip>(this, ToolTipClass);
+		ItemToolTip->InventorySlotBeingHovered = this;
 	}
 
 }
@@ -26,6 +28,12 @@ void UCpp_WGT_InventoryItemSlot::NativeOnInitialized() {
 void UCpp_WGT_InventoryItemSlot::NativeConstruct() {
 	Super::NativeConstruct();
 	
+	RefreshSlot();
+}
+
+void UCpp_WGT_InventoryItemSlot::RefreshSlot() {
+	DisplayedQuantity = INDEX_NONE;
+	DisplayedItemID = ItemReference ? ItemReference->ID : NAME_None;
 	if (ItemReference) {
 		switch (ItemReference->ItemQuality) {
 			case EItemQuality::Common:
@@ -47,40 +55,59 @@ void UCpp_WGT_InventoryItemSlot::NativeConstruct() {
 				break;
 		}	
 
-		IMG_Icon->SetBrushFromTexture(ItemReference->ItemAssetData.Icon);
+		// A sub-region of a shared atlas page when the atlas is set up, so the whole grid draws in a few batches
+		UCpp_ItemIconSubsystem::SetItemIcon(IMG_Icon, ItemReference);
+		IMG_Icon->SetVisibility(ESlateVisibility::HitTestInvisible);
+		if (GetToolTip() != ItemToolTip) {
+			SetToolTip(ItemToolTip);
+		}
 		if (ItemReference->ItemNumericData.bIsStackable) {
-			TXT_Quantity->SetText(FText::AsNumber(ItemReference->Quantity));
+			TXT_Quantity->SetVisibility(ESlateVisibility::HitTestInvisible);
+			RefreshQuantity();
 		}
 		else {
 			TXT_Quantity->SetVisibility(ESlateVisibility::Collapsed);
 		}
 	}
+	else {
+		// Empty slot, kept on screen so stacks can be dropped into it
+		Border_Item->SetBrushColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.5f));
+		IMG_Icon->SetVisibility(ESlateVisibility::Hidden);
+		TXT_Quantity->SetVisibility(ESlateVisibility::Collapsed);
+		// The tooltip would still describe the item that was here before
+		if (GetToolTip()) {
+			SetToolTip(nullptr);
+		}
+	}
+}
+
+bool UCpp_WGT_InventoryItemSlot::IsShowingItem(const UItemBase* Item) const {
+	return ItemReference == Item && Item && DisplayedItemID == Item->ID;
+}
+
+void UCpp_WGT_InventoryItemSlot::RefreshQuantity() {
+	if (ItemReference && ItemReference->ItemNumericData.bIsStackable && ItemReference->Quantity != DisplayedQuantity) {
+		DisplayedQuantity = ItemReference->Quantity;
+		TXT_Quantity->SetText(FText::AsNumber(DisplayedQuantity));
+	}
 }
 
 void UCpp_WGT_InventoryItemSlot::NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation) {
 	Super::NativeOnDragDetected(InGeometry, InMouseEvent, OutOperation);
 	
-	if (DragItemVisualClass) {
-		TObjectPtr<UCpp_WGT_DragItem> DragVisual = CreateWidget<UCpp_WGT_DragItem>(this, DragItemVisualClass);
-		DragVisual->IMG_Icon->SetBrushFromTexture(ItemReference->ItemAssetData.Icon);
-		DragVisual->Border_Item->SetBrushColor(Border_Item->GetBrushColor());
-		DragVisual->TXT_Quantity->SetText(FText::AsNumber(ItemReference->Quantity));
-
-		UCpp_ItemDragDropOperation* DragItemOperation = NewObject<UCpp_ItemDragDropOperation>();
-		DragItemOperation->SourceItem = ItemReference;
-		DragItemOperation->SourceInventory = ItemReference->OwningInventory;
-		
-		DragItemOperation->DefaultDragVisual = DragVisual;
-		DragItemOperation->Pivot = EDragPivot::TopLeft; // Tells it to drag from the top left corner of the widget
-
-		OutOperation = DragItemOperation;
+	if (DragItemVisualClass && ItemReference) {
+		// The HUD owns the one drag visual and operation, they are rebound to this slot's item instead of created per drag
+		const APlayerController* OwningPlayer = GetOwningPlayer();
+		if (ACpp_InventoryHUD* HUD = OwningPlayer ? OwningPlayer->GetHUD<ACpp_InventoryHUD>() : nullptr) {
+			OutOperation = HUD->BeginItemDrag(DragItemVisualClass, ItemReference, Border_Item->GetBrushColor());
+		}
 	}
 }
 
 FReply UCpp_WGT_InventoryItemSlot::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) {
 	FReply Reply = Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
 	
-	if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton) {
+	if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton && ItemReference) {
 		return Reply.Handled().DetectDrag(TakeWidget(), EKeys::LeftMouseButton);
 	}
 
@@ -95,7 +122,15 @@ void UCpp_WGT_InventoryItemSlot::NativeOnMouseLeave(const FPointerEvent& InMouse
 }
 
 bool UCpp_WGT_InventoryItemSlot::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) {
-	 Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
+	Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
 
-	 return true;
- }
+	const UCpp_ItemDragDropOperation* ItemDragDrop = Cast<UCpp_ItemDragDropOperation>(InOperation);
+
+	// Rearranged Within The Same Inventory, Swapping With Whatever Is In This Slot. Only The Two Slots Update.
+	if (ItemDragDrop && ItemDragDrop->SourceItem && InventoryReference && ItemDragDrop->SourceInventory == InventoryReference) {
+		InventoryReference->MoveItemToSlot(ItemDragDrop->SourceItem, SlotIndex);
+		return true;
+	}
+	// Anything Else (Another Inventory...) Is Left To The Panel
+	return false;
+}
@@ -7,6 +7,7 @@
 #include "Components/Cpp_AC_Inventory.h"
 #include "ItemBase.h"
 #include "UI/Inventory/Cpp_ItemDragDropOperation.h"
+#include "UI/Cpp_WGT_MainMenu.h"
 
 // Engine
 #include "Components/TextBlock.h"
@@ -18,25 +19,41 @@
 void UCpp_WGT_InventoryPanel::NativeOnInitialized() {
 	Super::NativeOnInitialized();
 
+	WeightInfoText.Bind(TB_WeightInfo);
+	CapacityInfoText.Bind(TB_CapacityInfo);
+
 	PlayerCharacter = Cast<ACpp_InventorySystemCharacter>(GetOwningPlayerPawn());
 
 	if (PlayerCharacter) {
 		InventoryReference = PlayerCharacter->GetInventory();
 		if (InventoryReference) {			
-			// Call Refresh Inventory From Binding Delegate Of OnInventoryUpdated
-			InventoryReference->OnInventoryUpdated.AddUObject(this, &UCpp_WGT_InventoryPanel::RefreshInventory);
-			SetInfoText();
+			// The change set says which slots need updating, so unchanged slots keep their cached paint
+			InventoryReference->OnInventoryChanged.AddUObject(this, &UCpp_WGT_InventoryPanel::OnInventoryChanged);
+			RefreshInventory();
 		}
 	}
 
 }
 
+void UCpp_WGT_InventoryPanel::NativeDestruct() {
+	Super::NativeDestruct();
+
+	if (InventoryReference) {
+		InventoryReference->OnInventoryChanged.RemoveAll(this);
+	}
+}
+
 bool UCpp_WGT_InventoryPanel::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) {
 	Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
 
 	const UCpp_ItemDragDropOperation* ItemDragDrop = Cast<UCpp_ItemDragDropOperation>(InOperation);
 	
-	if (InventoryReference && ItemDragDrop->SourceItem) {
+	if (InventoryReference && ItemDragDrop && ItemDragDrop->SourceItem) {
+		// Dragged In From Another Inventory (Container, Vendor...), Move As Much Of The Stack As Fits
+		if (ItemDragDrop->SourceInventory && ItemDragDrop->SourceInventory != InventoryReference) {
+			ItemDragDrop->SourceInventory->TransferItem(ItemDragDrop->SourceItem, InventoryReference, ItemDragDrop->SourceItem->Quantity);
+			return true;
+		}
 		UE_LOG(LogTemp, Warning, TEXT("Item Dropped Over Inventory, Cancelling Drop"));
 		// Returning True Cancels The Drop
 		return true;
@@ -46,27 +63,116 @@ bool UCpp_WGT_InventoryPanel::NativeOnDrop(const FGeometry& InGeometry, const FD
 }
 
 void UCpp_WGT_InventoryPanel::RefreshInventory() {	
+	if (!bPanelActive) {
+		bRefreshPending = true;
+		return;
+	}
+	bRefreshPending = false;
+
 	if (InventoryReference && InventoryItemSlotClass) {		
-		WB_InventoryPanel->ClearChildren();		
-		// Iterate Through Inventory
-		for (UItemBase* const& InventoryItem : InventoryReference->GetInventoryContents()) {
-			UCpp_WGT_InventoryItemSlot* ItemSlot = CreateWidget<UCpp_WGT_InventoryItemSlot>(this, InventoryItemSlotClass);
-			ItemSlot->SetItemReference(InventoryItem);			
-			WB_InventoryPanel->AddChildToWrapBox(ItemSlot);
-		}	
+		const TConstArrayView<TObjectPtr<UItemBase>> Contents = InventoryReference->GetInventoryContentsView();
+
+		// A cell for every slot up to the capacity, stacks can be dragged into any of them and not only up to the last used one
+		const int32 NumCells = FMath::Max(InventoryReference->GetSlotsCapacity(), Contents.Num());
+
+		// Iterate Through Inventory Slots, giving every slot (empty ones too) the slot widget at its position
+		for (int32 Index = 0; Index < NumCells; ++Index) {
+			UItemBase* SlotItem = Contents.IsValidIndex(Index) ? Contents[Index].Get() : nullptr;
+			UCpp_WGT_InventoryItemSlot* ItemSlot = nullptr;
+			if (SlotWidgets.IsValidIndex(Index)) {
+				ItemSlot = SlotWidgets[Index];
+			}
+			else {
+				ItemSlot = CreateWidget<UCpp_WGT_InventoryItemSlot>(this, InventoryItemSlotClass);
+				SlotWidgets.Add(ItemSlot);
+			}
+			ItemSlot->SetInventorySlot(InventoryReference, Index);
+			// A slot that keeps showing the same stack, or stays empty, is left alone so its cached paint stays valid
+			const bool bSlotUnchanged = SlotItem ? ItemSlot->IsShowingItem(SlotItem) : !ItemSlot->GetItemReference();
+			if (!bSlotUnchanged || !ItemSlot->GetParent()) {
+				ItemSlot->SetItemReference(SlotItem);
+				ItemSlot->RefreshSlot();
+			}
+			else {
+				ItemSlot->RefreshQuantity();
+			}
+			if (!ItemSlot->GetParent()) {
+				WB_InventoryPanel->AddChildToWrapBox(ItemSlot);
+			}
+		}
+
+		// Slots past the end are taken out of the panel but kept for the next time the inventory grows
+		for (int32 Index = NumCells; Index < SlotWidgets.Num(); ++Index) {
+			if (SlotWidgets[Index]->GetParent()) {
+				SlotWidgets[Index]->SetItemReference(nullptr);
+				SlotWidgets[Index]->RemoveFromParent();
+			}
+		}
 		SetInfoText();
+
+		if (OwningMenu.IsValid()) {
+			OwningMenu->NotifyContentChanged();
+		}
 	}
 }
 
-void UCpp_WGT_InventoryPanel::SetInfoText() const {
-	
-	const FString WeightInfo = {"Weight: " + FString::SanitizeFloat(InventoryReference->GetInventoryTotalWeight()) + "kg / "
-									  + FString::SanitizeFloat(InventoryReference->GetWeightCapacity()) + "kg"};
-	TB_WeightInfo->SetText(FText::FromString(WeightInfo));
+void UCpp_WGT_InventoryPanel::OnInventoryChanged(const FInventoryChangeSet& ChangeSet) {
+	if (!bPanelActive) {
+		bRefreshPending = true;
+		return;
+	}
+	if (ChangeSet.bLayoutChanged) {
+		RefreshInventory();
+		return;
+	}
+
+	// Slots keep their stacks, so an added, removed or moved stack only touches the cells it left and entered
+	for (const int32 ChangedSlot : ChangeSet.ChangedSlots) {
+		if (!SlotWidgets.IsValidIndex(ChangedSlot) || !SlotWidgets[ChangedSlot]->GetParent()) {
+			// The inventory grew past the cells on screen
+			RefreshInventory();
+			return;
+		}
+		UCpp_WGT_InventoryItemSlot* ItemSlot = SlotWidgets[ChangedSlot];
+		ItemSlot->SetItemReference(InventoryReference->GetItemInSlot(ChangedSlot));
+		ItemSlot->RefreshSlot();
+	}
+
+	for (const UItemBase* ChangedItem : ChangeSet.ChangedItems) {
+		// Stacks emptied since the change was recorded have left their slot already
+		if (ChangedItem->OwningInventory == InventoryReference && SlotWidgets.IsValidIndex(ChangedItem->SlotIndex)) {
+			SlotWidgets[ChangedItem->SlotIndex]->RefreshQuantity();
+		}
+	}
+	SetInfoText();
+
+	if (OwningMenu.IsValid()) {
+		OwningMenu->NotifyContentChanged();
+	}
+}
+
+void UCpp_WGT_InventoryPanel::SetPanelActive(const bool bActive) {
+	bPanelActive = bActive;
+	if (bPanelActive && bRefreshPending) {
+		RefreshInventory();
+	}
+}
 
-	const FString CapacityInfo = {"Capacity: " + FString::FromInt(InventoryReference->GetInventoryContents().Num()) + "/"
-									  + FString::FromInt(InventoryReference->GetSlotsCapacity())};
-	TB_CapacityInfo->SetText(FText::FromString(CapacityInfo));
+void UCpp_WGT_InventoryPanel::SetInfoText() {
+	static const FTextFormat WeightInfoFormat(FText::FromString("Weight: {0}kg / {1}kg"));
+	static const FTextFormat CapacityInfoFormat(FText::FromString("Capacity: {0}/{1}"));
+
+	// Most inventory events change neither, then nothing is formatted and the text blocks stay valid
+	WeightInfoText.Set(MakeTuple(InventoryReference->GetInventoryTotalWeight(), InventoryReference->GetWeightCapacity()), [](const TTuple<float, float>& Weight) {
+		return FText::Format(WeightInfoFormat,
+			FText::AsNumber(Weight.Get<0>(), &Cpp_TextFormatting::GetDecimalOptions()),
+			FText::AsNumber(Weight.Get<1>(), &Cpp_TextFormatting::GetDecimalOptions()));
+	});
+	CapacityInfoText.Set(MakeTuple(InventoryReference->GetNumItems(), InventoryReference->GetSlotsCapacity()), [](const TTuple<int32, int32>& Capacity) {
+		return FText::Format(CapacityInfoFormat,
+			FText::AsNumber(Capacity.Get<0>(), &Cpp_TextFormatting::GetIntegerOptions()),
+			FText::AsNumber(Capacity.Get<1>(), &Cpp_TextFormatting::GetIntegerOptions()));
+	});
 }
 
 
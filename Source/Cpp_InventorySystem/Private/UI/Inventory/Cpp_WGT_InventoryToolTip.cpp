@@ -6,28 +6,51 @@
 #include "ItemBase.h"
 #include "Components/TextBlock.h"
 
+void UCpp_WGT_InventoryToolTip::NativeOnInitialized() {
+	Super::NativeOnInitialized();
+
+	ItemTypeText.Bind(TXT_ItemType);
+	ItemNameText.Bind(TXT_ItemName);
+	UsageText.Bind(TXT_Usage);
+	DescriptionText.Bind(TXT_ItemDescription);
+	DamageValueText.Bind(TXT_DamageValue);
+	ArmorRatingText.Bind(TXT_ArmorRating);
+	StackWeightText.Bind(TXT_StackWeight);
+	MaxStackSizeText.Bind(TXT_MaxStackSize);
+}
+
 void UCpp_WGT_InventoryToolTip::NativeConstruct() {
 	Super::NativeConstruct();
 
 	UItemBase* ItemBeingHovered = InventorySlotBeingHovered->GetItemReference();
 	if (ItemBeingHovered) {
+		// Tooltips are pooled, rows collapsed for the previous item have to come back before this one's type decides
+		TXT_DamageValue->SetVisibility(ESlateVisibility::Visible);
+		TXT_ArmorRating->SetVisibility(ESlateVisibility::Visible);
+		TXT_Usage->SetVisibility(ESlateVisibility::Visible);
+		TXT_MaxStackSize->SetVisibility(ESlateVisibility::Visible);
+
 		switch (ItemBeingHovered->ItemType) {
 			case EItemType::Weapon:
+				ItemTypeText.Set(FText::FromString("Weapon"));
 				break;
 			case EItemType::Armor:
+				ItemTypeText.Set(FText::FromString("Armor"));
 				break;
 			case EItemType::Consumable:
-				TXT_ItemType->SetText(FText::FromString("Consumable"));
+				ItemTypeText.Set(FText::FromString("Consumable"));
 				TXT_DamageValue->SetVisibility(ESlateVisibility::Collapsed);
 				TXT_ArmorRating->SetVisibility(ESlateVisibility::Collapsed);
 				TXT_MaxStackSize->SetVisibility(ESlateVisibility::Collapsed);
 				break;
 			case EItemType::Spell:
+				ItemTypeText.Set(FText::FromString("Spell"));
 				break;
 			case EItemType::Quest:
+				ItemTypeText.Set(FText::FromString("Quest Item"));
 				break;
 			case EItemType::Other:
-				TXT_ItemType->SetText(FText::FromString("Miscellaneous Item"));
+				ItemTypeText.Set(FText::FromString("Miscellaneous Item"));
 				TXT_DamageValue->SetVisibility(ESlateVisibility::Collapsed);
 				TXT_ArmorRating->SetVisibility(ESlateVisibility::Collapsed);
 				TXT_Usage->SetVisibility(ESlateVisibility::Collapsed);					
@@ -36,17 +59,26 @@ void UCpp_WGT_InventoryToolTip::NativeConstruct() {
 				break;
 		}
 
-		TXT_ItemName->SetText(ItemBeingHovered->ItemTextData.ItemName);
-		TXT_DamageValue->SetText(FText::AsNumber(ItemBeingHovered->ItemStatistics.DamageValue));
-		TXT_ArmorRating->SetText(FText::AsNumber(ItemBeingHovered->ItemStatistics.ArmorRating));
-		TXT_Usage->SetText(ItemBeingHovered->ItemTextData.UsageText);
-		TXT_ItemDescription->SetText(ItemBeingHovered->ItemTextData.ItemDescription);
-		const FString WeightInfo = {"Weight: " + FString::SanitizeFloat(ItemBeingHovered->GetItemStackWeight()) + " kg"};
-		TXT_StackWeight->SetText(FText::FromString(WeightInfo));
+		static const FTextFormat WeightInfoFormat(FText::FromString("Weight: {0} kg"));
+		static const FTextFormat StackInfoFormat(FText::FromString("Max Stack Size: {0}"));
+
+		ItemNameText.Set(ItemBeingHovered->ItemTextData.ItemName);
+		UsageText.Set(ItemBeingHovered->ItemTextData.UsageText);
+		DescriptionText.Set(ItemBeingHovered->ItemTextData.ItemDescription);
+		DamageValueText.Set(ItemBeingHovered->ItemStatistics.DamageValue, [](const float DamageValue) {
+			return FText::AsNumber(DamageValue, &Cpp_TextFormatting::GetDecimalOptions());
+		});
+		ArmorRatingText.Set(ItemBeingHovered->ItemStatistics.ArmorRating, [](const float ArmorRating) {
+			return FText::AsNumber(ArmorRating, &Cpp_TextFormatting::GetDecimalOptions());
+		});
+		StackWeightText.Set(ItemBeingHovered->GetItemStackWeight(), [](const float StackWeight) {
+			return FText::Format(WeightInfoFormat, FText::AsNumber(StackWeight, &Cpp_TextFormatting::GetDecimalOptions()));
+		});
 
 		if (ItemBeingHovered->ItemNumericData.bIsStackable) {
-			const FString StackInfo = {"Max Stack Size: " + FString::FromInt(ItemBeingHovered->ItemNumericData.MaxStackSize)};
-			TXT_MaxStackSize->SetText(FText::FromString(StackInfo));
+			MaxStackSizeText.Set(ItemBeingHovered->ItemNumericData.MaxStackSize, [](const int32 MaxStackSize) {
+				return FText::Format(StackInfoFormat, FText::AsNumber(MaxStackSize, &Cpp_TextFormatting::GetIntegerOptions()));
+			});
 			TXT_MaxStackSize->SetVisibility(ESlateVisibility::Visible);
 		}
 		else {
@@ -2,6 +2,7 @@
 
 
 #include "World/InterfaceTestActor.h"
+#include "Subsystems/Cpp_FocusHighlightSubsystem.h"
 
 // Sets default values
 AInterfaceTestActor::AInterfaceTestActor()
@@ -30,9 +31,7 @@ void AInterfaceTestActor::Tick(float DeltaTime)
 }
 
 void AInterfaceTestActor::BeginFocus() {
-	if (Mesh) {
-		Mesh->SetRenderCustomDepth(true);
-	}
+	UCpp_FocusHighlightSubsystem::SetFocusHighlight(Mesh, true);
 }
 
 void AInterfaceTestActor::BeginInteract() {
@@ -40,10 +39,7 @@ void AInterfaceTestActor::BeginInteract() {
 }
 
 void AInterfaceTestActor::EndFocus() {
-	if (Mesh) {
-		Mesh->SetRenderCustomDepth(false);
-	}
-
+	UCpp_FocusHighlightSubsystem::SetFocusHighlight(Mesh, false);
 }
 
 void AInterfaceTestActor::EndInteract() {
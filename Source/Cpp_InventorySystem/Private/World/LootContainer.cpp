@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "World/LootContainer.h"
+#include "Components/Cpp_AC_Inventory.h"
+#include "Data/Cpp_LootTable.h"
+#include "Subsystems/Cpp_FocusHighlightSubsystem.h"
+#include "Subsystems/Cpp_SignificanceSubsystem.h"
+#include "../Cpp_InventorySystemCharacter.h"
+#include "../Cpp_InventorySystem.h"
+#include "TimerManager.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/ConstructorHelpers.h"
+
+// Containers with an inventory in memory, compare against the number of containers in the level
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Materialized Containers"), STAT_MaterializedContainers, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Container Loot Rolls"), STAT_ContainerLootRolls, STATGROUP_Inventory);
+
+// Sets default values
+ALootContainer::ALootContainer() {
+	PrimaryActorTick.bCanEverTick = false;
+
+	ContainerMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ContainerMesh"));
+	// Without a mesh there is nothing to see, trace or simulate, subclasses replace this placeholder with the bag
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> DefaultMesh(TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (DefaultMesh.Succeeded()) {
+		ContainerMesh->SetStaticMesh(DefaultMesh.Object);
+		ContainerMesh->SetRelativeScale3D(FVector(0.4f));
+	}
+	// Placed chests stay where they were put, thousands of them mustn't be a rigid body each. Spawned loot bags simulate.
+	ContainerMesh->SetSimulatePhysics(false);
+	SetRootComponent(ContainerMesh);
+
+	// Created on demand, an unopened container is just its mesh
+	ContainerInventory = nullptr;
+	InventorySlotsCapacity = 20;
+	InventoryWeightCapacity = 100.0f;
+
+	InstanceInteractableData.InteractableType = EInteractableType::Container;
+	InstanceInteractableData.Name = FText::FromString("Loot Bag");
+	InstanceInteractableData.Action = FText::FromString("Loot");
+	InstanceInteractableData.InteractionDuration = 1.0f;
+	bDestroyWhenEmpty = false;
+
+	LootTable = nullptr;
+	LootSeed = 0;
+	ContentsReleaseDelay = 30.0f;
+	bContentsModified = false;
+}
+
+void ALootContainer::BeginPlay() {
+	Super::BeginPlay();
+
+	InstanceInteractableData.InteractableType = EInteractableType::Container;
+	UpdateInteractableData();
+
+	UCpp_SignificanceSubsystem::RegisterItem(this, ContainerMesh);
+}
+
+void ALootContainer::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	if (ContainerInventory) {
+		DEC_DWORD_STAT(STAT_MaterializedContainers);
+	}
+	UCpp_SignificanceSubsystem::UnregisterItem(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UCpp_AC_Inventory* ALootContainer::GetOrCreateContainerInventory() {
+	if (ContainerInventory) {
+		return ContainerInventory;
+	}
+
+	// No name, a released inventory may still be waiting for the garbage collector under the old one
+	ContainerInventory = NewObject<UCpp_AC_Inventory>(this);
+	// The inventory has nothing to do per frame, containers in the world shouldn't cost a tick each
+	ContainerInventory->PrimaryComponentTick.bStartWithTickEnabled = false;
+	ContainerInventory->SetSlotsCapacity(InventorySlotsCapacity);
+	ContainerInventory->SetWeightCapacity(InventoryWeightCapacity);
+	ContainerInventory->RegisterComponent();
+	INC_DWORD_STAT(STAT_MaterializedContainers);
+
+	if (LootTable) {
+		INC_DWORD_STAT(STAT_ContainerLootRolls);
+		LootTable->RollIntoInventory(GetLootSeed(), ContainerInventory);
+	}
+	bContentsModified = false;
+
+	UpdateInteractableData();
+	return ContainerInventory;
+}
+
+int32 ALootContainer::GetLootSeed() const {
+	// FString hashes are stable between runs, FName hashes aren't
+	return LootSeed != 0 ? LootSeed : static_cast<int32>(GetTypeHash(GetName()));
+}
+
+void ALootContainer::ReleaseContents() {
+	// Only contents the seed rolls again can be thrown away
+	if (!ContainerInventory || !LootTable || bContentsModified) {
+		return;
+	}
+
+	ContainerInventory->DestroyComponent();
+	ContainerInventory = nullptr;
+	DEC_DWORD_STAT(STAT_MaterializedContainers);
+	UpdateInteractableData();
+}
+
+void ALootContainer::ReserveCapacity(const int32 NumStacks, const float TotalWeight) {
+	UCpp_AC_Inventory* Inventory = GetOrCreateContainerInventory();
+	Inventory->SetSlotsCapacity(FMath::Max(NumStacks, Inventory->GetNumItems()));
+	// Some slack for the rounding of the fixed point weight totals
+	Inventory->SetWeightCapacity(Inventory->GetInventoryTotalWeight() + TotalWeight + 1.0f);
+	// Whatever is moved in wasn't rolled from the seed
+	bContentsModified = true;
+}
+
+void ALootContainer::UpdateInteractableData() {
+	InteractableData = InstanceInteractableData;
+	// Quantity is what the interaction widget shows next to the name, the number of stacks inside here
+	const int32 NumStacks = ContainerInventory ? ContainerInventory->GetNumItems() : 0;
+	InteractableData.Quantity = static_cast<int8>(FMath::Min(NumStacks, static_cast<int32>(MAX_int8)));
+}
+
+void ALootContainer::BeginFocus() {
+	UCpp_FocusHighlightSubsystem::SetFocusHighlight(ContainerMesh, true);
+
+	GetWorldTimerManager().ClearTimer(ContentsReleaseTimer);
+	GetOrCreateContainerInventory();
+}
+
+void ALootContainer::EndFocus() {
+	UCpp_FocusHighlightSubsystem::SetFocusHighlight(ContainerMesh, false);
+
+	if (LootTable && ContentsReleaseDelay > 0.0f && !bContentsModified) {
+		GetWorldTimerManager().SetTimer(ContentsReleaseTimer, this, &ALootContainer::ReleaseContents, ContentsReleaseDelay, false);
+	}
+}
+
+void ALootContainer::BeginInteract() {
+	GetOrCreateContainerInventory();
+}
+
+void ALootContainer::Interact(ACpp_InventorySystemCharacter* PlayerChracter) {
+	if (!PlayerChracter || IsPendingKillPending()) {
+		return;
+	}
+
+	UCpp_AC_Inventory* PlayerInventory = PlayerChracter->GetInventory();
+	if (!PlayerInventory) {
+		UE_LOG(LogTemp, Warning, TEXT("Player Inventory is null!"));
+		return;
+	}
+
+	// One pass over every stack, both inventories broadcast a single update
+	UCpp_AC_Inventory* Inventory = GetOrCreateContainerInventory();
+	const int32 NumTaken = Inventory->TransferAll(PlayerInventory);
+	if (NumTaken > 0) {
+		bContentsModified = true;
+	}
+	else if (!Inventory->IsEmpty()) {
+		UE_LOG(LogTemp, Warning, TEXT("Nothing in %s fits into the Player Inventory!"), *GetName());
+	}
+
+	if (bDestroyWhenEmpty && Inventory->IsEmpty()) {
+		Destroy();
+		return;
+	}
+	UpdateInteractableData();
+	PlayerChracter->UpdateInteractionWidget();
+}
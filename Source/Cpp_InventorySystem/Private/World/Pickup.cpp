@@ -4,7 +4,14 @@
 #include "World/Pickup.h"
 #include "ItemBase.h"
 #include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
 #include "Components/Cpp_AC_Inventory.h"
+#include "Data/Cpp_ItemCatalog.h"
+#include "Cpp_ItemPool.h"
+#include "Subsystems/Cpp_FocusHighlightSubsystem.h"
+#include "Subsystems/Cpp_PickupSubsystem.h"
+#include "Subsystems/Cpp_PickupSpawnSubsystem.h"
+#include "Subsystems/Cpp_SignificanceSubsystem.h"
 #include "../Cpp_InventorySystemCharacter.h"
 
 
@@ -22,7 +29,27 @@ APickup::APickup() {
 void APickup::BeginPlay() {
 	Super::BeginPlay();
 
-	InitializePickup(UItemBase::StaticClass(), ItemQuantity);
+	UCpp_SignificanceSubsystem::RegisterItem(this, PickupMesh);
+
+	// Dropped pickups are initialized by whoever spawned them
+	if(!ItemRowHandle.IsNull() || !CatalogItemID.IsNone()) {
+		UCpp_PickupSpawnSubsystem::InitializePlacedPickup(this);
+	}
+}
+
+void APickup::EnsureInitialized() {
+	if(!ItemReference) {
+		InitializePickup(UItemBase::StaticClass(), ItemQuantity);
+	}
+}
+
+void APickup::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	if (UCpp_PickupSubsystem* Pickups = GetWorld()->GetSubsystem<UCpp_PickupSubsystem>()) {
+		Pickups->UnregisterPickup(this);
+	}
+	UCpp_SignificanceSubsystem::UnregisterItem(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void APickup::InitializePickup(const TSubclassOf<UItemBase> BaseClass, const int32 InQuantity) {
@@ -30,23 +57,36 @@ void APickup::InitializePickup(const TSubclassOf<UItemBase> BaseClass, const int
 		// Get the item data from the data table using the DesiredItemID
 		const FItemData* ItemData = ItemRowHandle.GetRow<FItemData>(ItemRowHandle.RowName.ToString());
 
-		ItemReference = NewObject<UItemBase>(this, BaseClass);
-		
-		ItemReference->ID = ItemData->ID;
-		ItemReference->ItemQuality = ItemData->ItemQuality;
-		ItemReference->ItemTextData = ItemData->ItemTextData;
-		ItemReference->ItemType = ItemData->ItemType;
-		ItemReference->ItemAssetData = ItemData->ItemAssetData;
-		ItemReference->ItemNumericData = ItemData->ItemNumericData;
-		ItemReference->ItemStatistics = ItemData->ItemStatistics;
-		// Sets whether the item is stackable or not 
-		ItemReference->ItemNumericData.bIsStackable = ItemData->ItemNumericData.MaxStackSize > 1;
-		// Set the quantity of the item
-		InQuantity <= 0 ? ItemReference->SetQuantity(1) : ItemReference->SetQuantity(InQuantity);
-
-		PickupMesh->SetStaticMesh(ItemData->ItemAssetData.Mesh);
-
-		UpdateInteractableData();
+		InitializeFromItemData(BaseClass, *ItemData, InQuantity);
+	}
+	else if(!CatalogItemID.IsNone()) {
+		// Get the item data from the memory-mapped catalog, only this row gets decoded
+		const UGameInstance* GameInstance = GetGameInstance();
+		const UCpp_ItemCatalogSubsystem* CatalogSubsystem = GameInstance ? GameInstance->GetSubsystem<UCpp_ItemCatalogSubsystem>() : nullptr;
+
+		FItemData ItemData;
+		if(CatalogSubsystem && CatalogSubsystem->GetCatalog().FindItemData(CatalogItemID, ItemData, !IsRunningDedicatedServer())) {
+			InitializeFromItemData(BaseClass, ItemData, InQuantity);
+		}
+		else {
+			UE_LOG(LogTemp, Warning, TEXT("Item %s was not found in the Item Catalog!"), *CatalogItemID.ToString());
+		}
+	}
+}
+
+void APickup::InitializeFromItemData(const TSubclassOf<UItemBase> BaseClass, const FItemData& ItemData, const int32 InQuantity) {
+	ItemReference = NewObject<UItemBase>(this, BaseClass);
+	ItemReference->InitializeFromItemData(ItemData);
+	// Set the quantity of the item
+	InQuantity <= 0 ? ItemReference->SetQuantity(1) : ItemReference->SetQuantity(InQuantity);
+
+	PickupMesh->SetStaticMesh(ItemData.ItemAssetData.Mesh);
+
+	UpdateInteractableData();
+
+	// Placed pickups only take in drops, they are never merged away themselves
+	if (UCpp_PickupSubsystem* Pickups = GetWorld()->GetSubsystem<UCpp_PickupSubsystem>()) {
+		Pickups->RegisterPickup(this, false);
 	}
 }
 
@@ -60,6 +100,33 @@ void APickup::InitializeDrop(UItemBase* ItemToDrop, const int32 InQuantity) {
 
 	UpdateInteractableData();
 
+	if (UCpp_PickupSubsystem* Pickups = GetWorld()->GetSubsystem<UCpp_PickupSubsystem>()) {
+		Pickups->RegisterPickup(this, true);
+	}
+}
+
+int32 APickup::AbsorbPickup(APickup* Other) {
+	if (!Other || Other == this || !ItemReference || !Other->ItemReference || ItemReference->ID != Other->ItemReference->ID) {
+		return 0;
+	}
+
+	const int32 MovedQuantity = FMath::Min(Other->ItemReference->Quantity, ItemReference->ItemNumericData.MaxStackSize - ItemReference->Quantity);
+	if (MovedQuantity <= 0) {
+		return 0;
+	}
+	ItemReference->SetQuantity(ItemReference->Quantity + MovedQuantity);
+	Other->ItemReference->SetQuantity(Other->ItemReference->Quantity - MovedQuantity);
+	UpdateInteractableData();
+
+	if (Other->ItemReference->Quantity == 0) {
+		FCpp_ItemPool::Get().Release(Other->ItemReference);
+		Other->ItemReference = nullptr;
+		Other->Destroy();
+	}
+	else {
+		Other->UpdateInteractableData();
+	}
+	return MovedQuantity;
 }
 
 void APickup::UpdateInteractableData() {
@@ -71,15 +138,12 @@ void APickup::UpdateInteractableData() {
 }
 
 void APickup::BeginFocus() {
-	if(PickupMesh) {
-		PickupMesh->SetRenderCustomDepth(true);
-	}
+	EnsureInitialized();
+	UCpp_FocusHighlightSubsystem::SetFocusHighlight(PickupMesh, true);
 }
 
 void APickup::EndFocus() {
-	if(PickupMesh) {
-		PickupMesh->SetRenderCustomDepth(false);
-	}
+	UCpp_FocusHighlightSubsystem::SetFocusHighlight(PickupMesh, false);
 }
 
 void APickup::Interact(ACpp_InventorySystemCharacter* PlayerChracter) {
@@ -94,17 +158,23 @@ void APickup::TakePickup(const ACpp_InventorySystemCharacter* Taker) {
 			if(UCpp_AC_Inventory* PlayerInventory = Taker->GetInventory()) {
 				const FItemAddResult AddResult = PlayerInventory->HandleAddItem(ItemReference);
 				switch(AddResult.OperationResult) {
+					// Only what didn't fit is worth a log line, a full pickup is the common case
 					case EItemAddResult::IAR_NoItemsAdded:
+						UE_LOG(LogTemp, Warning, TEXT("%s"), *AddResult.GetResultMessage().ToString());
 						break;
-					case EItemAddResult::IAR_SomeItemsAdded:						
+					case EItemAddResult::IAR_SomeItemsAdded:
+						UE_LOG(LogTemp, Warning, TEXT("%s"), *AddResult.GetResultMessage().ToString());
 						UpdateInteractableData();
 						Taker->UpdateInteractionWidget();
 						break;
 					case EItemAddResult::IAR_AllItemsAdded:
+						// Fully merged into existing stacks, the now empty item can be recycled
+						if(ItemReference->Quantity == 0 && !ItemReference->OwningInventory) {
+							FCpp_ItemPool::Get().Release(ItemReference);
+						}
 						Destroy();
 						break;
 				}
-				UE_LOG(LogTemp, Warning, TEXT("%s"), *AddResult.ResultMessage.ToString());
 			}
 			else {
 				UE_LOG(LogTemp, Warning, TEXT("Player Inventory is null!"));
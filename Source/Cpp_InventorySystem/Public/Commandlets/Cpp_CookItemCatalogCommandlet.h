@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Cpp_CookItemCatalogCommandlet.generated.h"
+
+/**
+ * Bakes an FItemData data table into the memory-mapped item catalog format.
+ * Usage: -run=Cpp_CookItemCatalog -Table=/Game/Data/DT_Items.DT_Items [-Output=Catalog/Items.icat]
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_CookItemCatalogCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCpp_CookItemCatalogCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Cpp_PackItemIconAtlasCommandlet.generated.h"
+
+/**
+ * Packs the icons of an FItemData data table into atlas pages and writes the UCpp_ItemIconAtlas that maps item IDs to them.
+ * Items sharing an icon texture share its region. Every icon is resized to IconSize and surrounded by a copy of its
+ * edge pixels so filtering never bleeds in a neighbour.
+ * Usage: -run=Cpp_PackItemIconAtlas -Table=/Game/Data/DT_Items.DT_Items [-Output=/Game/UI/DA_ItemIconAtlas] [-IconSize=128] [-PageSize=2048]
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_PackItemIconAtlasCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCpp_PackItemIconAtlasCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -4,11 +4,73 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "../ItemDataStructs.h"
+#include "Components/Cpp_InventoryQuery.h"
+#include "Components/Cpp_InventoryCommandQueue.h"
 #include "Cpp_AC_Inventory.generated.h"
 
+class UItemBase;
+
+// What changed in the inventory since the last broadcast
+struct FInventoryChangeSet {
+	// Past this many changed stacks the change is treated as a layout change, listeners rebuild anyway
+	static constexpr int32 MaxTrackedItems = 32;
+
+	// Stacks were compacted or reordered in bulk, anything showing the contents by position has to rebuild
+	bool bLayoutChanged = false;
+	// Stacks that are still in the inventory but whose quantity changed
+	TArray<const UItemBase*, TInlineAllocator<MaxTrackedItems>> ChangedItems;
+	// Slots a stack was added to, removed from or moved in or out of, the other slots kept their stacks
+	TArray<int32, TInlineAllocator<MaxTrackedItems>> ChangedSlots;
+
+	FORCEINLINE bool IsEmpty() const { return !bLayoutChanged && ChangedItems.IsEmpty() && ChangedSlots.IsEmpty(); }
+
+	void MarkLayoutChanged() {
+		bLayoutChanged = true;
+		ChangedItems.Reset();
+		ChangedSlots.Reset();
+	}
+	void MarkSlotChanged(const int32 Slot) {
+		if (!bLayoutChanged) {
+			if (ChangedSlots.Num() >= MaxTrackedItems) {
+				MarkLayoutChanged();
+			}
+			else {
+				ChangedSlots.AddUnique(Slot);
+			}
+		}
+	}
+	void MarkItemChanged(const UItemBase* Item) {
+		if (!bLayoutChanged) {
+			if (ChangedItems.Num() >= MaxTrackedItems) {
+				MarkLayoutChanged();
+			}
+			else {
+				ChangedItems.AddUnique(Item);
+			}
+		}
+	}
+	void Reset() {
+		bLayoutChanged = false;
+		ChangedItems.Reset();
+		ChangedSlots.Reset();
+	}
+};
+
 DECLARE_MULTICAST_DELEGATE(FOnInventoryUpdated);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnInventoryChanged, const FInventoryChangeSet&);
 
-class UItemBase;
+UENUM(BlueprintType)
+enum class EInventorySortKey : uint8 {
+	// Ascending EItemType order
+	Type UMETA(DisplayName = "Type"),
+	// Highest quality first
+	Quality UMETA(DisplayName = "Quality"),
+	// Heaviest stack first
+	Weight UMETA(DisplayName = "Weight"),
+	// Most valuable stack first
+	SellValue UMETA(DisplayName = "Sell Value")
+};
 
 UENUM(BlueprintType)
 enum class EItemAddResult : uint8 {
@@ -17,14 +79,27 @@ enum class EItemAddResult : uint8 {
 	IAR_AllItemsAdded UMETA(DisplayName = "All Items Added")
 };
 
+// Why an add ended the way it did, picks the message FItemAddResult formats
+UENUM(BlueprintType)
+enum class EItemAddReason : uint8 {
+	IAR_AddedSingle UMETA(DisplayName = "Added Single Item"),
+	IAR_AddedStack UMETA(DisplayName = "Added Stack"),
+	IAR_AddedPartially UMETA(DisplayName = "Added Partially"),
+	IAR_NoWeight UMETA(DisplayName = "Item Has No Weight"),
+	IAR_OverWeightLimit UMETA(DisplayName = "Over Weight Limit"),
+	IAR_NoFreeSlot UMETA(DisplayName = "No Free Slot"),
+	IAR_NoRoomOrInvalid UMETA(DisplayName = "No Room Or Invalid Item"),
+	IAR_NoOwner UMETA(DisplayName = "No Owner")
+};
+
 USTRUCT(BlueprintType)
-struct FItemAddResult {
+struct CPP_INVENTORYSYSTEM_API FItemAddResult {
 	GENERATED_BODY()
 
 	FItemAddResult() :
 		ActualAmountAdded(0),
 		OperationResult(EItemAddResult::IAR_NoItemsAdded),
-		ResultMessage(FText::GetEmpty())
+		Reason(EItemAddReason::IAR_NoRoomOrInvalid)
 	{};
 
 	// Actual amount of items that was added to the inventory
@@ -33,33 +108,67 @@ struct FItemAddResult {
 	// Enum value indicating the result of the add item operation
 	UPROPERTY(BlueprintReadOnly, Category = "Item Add Result")
 	EItemAddResult OperationResult;
-	// Informational message about the result of the add item operation
+	// Enum value indicating why the operation ended that way
 	UPROPERTY(BlueprintReadOnly, Category = "Item Add Result")
-	FText ResultMessage;
+	EItemAddReason Reason;
+	// Name of the item that was added, the only argument of the message besides the amount
+	UPROPERTY(BlueprintReadOnly, Category = "Item Add Result")
+	FText ItemName;
+
+	// Informational message about the result of the add item operation.
+	// Formatted on first access only, server and AI adds that never read it don't pay for the formatting.
+	const FText& GetResultMessage() const;
 
 	// Static methods as they are not dependent on the state of the object
-	static FItemAddResult AddedNone(const FText& ErrorText) {
-		FItemAddResult AddedNoneResult;
-		AddedNoneResult.ActualAmountAdded = 0;
-		AddedNoneResult.OperationResult = EItemAddResult::IAR_NoItemsAdded;
-		AddedNoneResult.ResultMessage = ErrorText;
-		return AddedNoneResult;
+	static FItemAddResult AddedNone(const EItemAddReason InReason, const FText& InItemName) {
+		return Make(0, EItemAddResult::IAR_NoItemsAdded, InReason, InItemName);
 	}
-	static FItemAddResult AddedSome(const int32 SomeAmountAdded, const FText& ErrorText) {
-		FItemAddResult AddedSomeResult;
-		AddedSomeResult.ActualAmountAdded = SomeAmountAdded;
-		AddedSomeResult.OperationResult = EItemAddResult::IAR_SomeItemsAdded;
-		AddedSomeResult.ResultMessage = ErrorText;
-		return AddedSomeResult;
+	static FItemAddResult AddedSome(const int32 SomeAmountAdded, const FText& InItemName) {
+		return Make(SomeAmountAdded, EItemAddResult::IAR_SomeItemsAdded, EItemAddReason::IAR_AddedPartially, InItemName);
 	}
-	static FItemAddResult AddedAll(const int32 AmountAdded, const FText& Message) {
-		FItemAddResult AddedAllResult;
-		AddedAllResult.ActualAmountAdded = AmountAdded;
-		AddedAllResult.OperationResult = EItemAddResult::IAR_AllItemsAdded;
-		AddedAllResult.ResultMessage = Message;
-		return AddedAllResult;
+	static FItemAddResult AddedAll(const int32 AmountAdded, const EItemAddReason InReason, const FText& InItemName) {
+		return Make(AmountAdded, EItemAddResult::IAR_AllItemsAdded, InReason, InItemName);
 	}
 
+private:
+	mutable FText CachedResultMessage;
+	mutable bool bResultMessageFormatted = false;
+
+	static FItemAddResult Make(const int32 AmountAdded, const EItemAddResult InOperationResult, const EItemAddReason InReason, const FText& InItemName) {
+		FItemAddResult Result;
+		Result.ActualAmountAdded = AmountAdded;
+		Result.OperationResult = InOperationResult;
+		Result.Reason = InReason;
+		// FText shares its string, copying the name is a reference count bump
+		Result.ItemName = InItemName;
+		return Result;
+	}
+};
+
+// Running totals of the inventory contents, maintained incrementally on every quantity change.
+// Weights are stored in fixed-point so adding and removing the same items always returns to exactly the same total.
+struct CPP_INVENTORYSYSTEM_API FInventoryAggregates {
+	// Weight units per kg
+	static constexpr int64 WeightScale = 1000;
+
+	int64 TotalWeight = 0;
+	int32 TotalQuantity = 0;
+
+	int64 WeightByType[NumItemTypes] = {};
+	int32 QuantityByType[NumItemTypes] = {};
+
+	int64 WeightByQuality[NumItemQualities] = {};
+	int32 QuantityByQuality[NumItemQualities] = {};
+
+	// Accounts for a change in quantity of a stack, negative deltas remove
+	void AccountItem(const UItemBase* Item, const int32 QuantityDelta);
+	void AccountItem(const EItemType Type, const EItemQuality Quality, const int64 SingleWeight, const int32 QuantityDelta);
+
+	bool operator==(const FInventoryAggregates& Other) const;
+	bool operator!=(const FInventoryAggregates& Other) const { return !(*this == Other); }
+
+	static FORCEINLINE int64 ToFixedWeight(const float Weight) { return FMath::RoundToInt64(static_cast<double>(Weight) * WeightScale); }
+	static FORCEINLINE float FromFixedWeight(const int64 Weight) { return static_cast<float>(static_cast<double>(Weight) / WeightScale); }
 };
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
@@ -72,6 +181,8 @@ public:
 	// PROPERTIES & VARIABLES
 	//====================================================================================================================	
 	FOnInventoryUpdated OnInventoryUpdated;
+	// Broadcast together with OnInventoryUpdated, describes what changed for listeners that can update partially
+	FOnInventoryChanged OnInventoryChanged;
 
 
 	//====================================================================================================================
@@ -95,15 +206,65 @@ public:
 	UFUNCTION(Category = "Inventory")
 	void SplitExistingStack(UItemBase* InItem, const int32 AmountToSplit);
 
+	// Moves up to AmountToTransfer of InItem into Destination, filling its partial stacks before opening new ones.
+	// Only what Destination can hold is moved and each inventory broadcasts once. Returns the amount moved.
+	UFUNCTION(Category = "Inventory")
+	int32 TransferItem(UItemBase* InItem, UCpp_AC_Inventory* Destination, const int32 AmountToTransfer);
+	// Moves as much of every stack as Destination can hold in a single pass. Returns the amount moved.
+	UFUNCTION(Category = "Inventory")
+	int32 TransferAll(UCpp_AC_Inventory* Destination);
+	// How many of InItem this inventory could take right now, counting room in partial stacks and free slots
+	UFUNCTION(Category = "Inventory")
+	int32 CalculateAcceptableAmount(const UItemBase* InItem, const int32 RequestedAmount) const;
+
+	// Filters the contents by type, quality, statistic ranges and name prefix without copying them.
+	// The view is only valid until the next query or change to the inventory.
+	TConstArrayView<UItemBase*> QueryItems(const FInventoryQuery& Query) const;
+
+	// Adds up to Amount of an item definition without needing a pickup, split over as many stacks as it takes.
+	// Returns the amount that fit.
+	int32 AddAmountOfItem(const FItemData& ItemData, const int32 Amount);
+
+	// Puts the stack in TargetSlot, swapping with the stack already there. Slots the player arranged stay where they are,
+	// only the two slots involved change. Returns false if the item isn't in this inventory or the slot is out of capacity.
+	UFUNCTION(Category = "Inventory")
+	bool MoveItemToSlot(UItemBase* InItem, const int32 TargetSlot);
+	UFUNCTION(Category = "Inventory")
+	bool SwapSlots(const int32 SlotA, const int32 SlotB);
+
+	// Merges every partial stack of the same item in a single pass, then stable sorts the contents by SortKey.
+	// Empty slots are squeezed out. Broadcasts a single layout change.
+	UFUNCTION(Category = "Inventory")
+	void CompactAndSort(const EInventorySortKey SortKey);
+
+	// Defers OnInventoryUpdated until the outermost batch ends, see FInventoryUpdateBatch
+	void BeginUpdateBatch();
+	void EndUpdateBatch();
+
 	// Getters
 	UFUNCTION(Category = "Inventory")
-	FORCEINLINE float GetInventoryTotalWeight() const { return InventoryTotalWeight;  };
+	FORCEINLINE float GetInventoryTotalWeight() const { return FInventoryAggregates::FromFixedWeight(Aggregates.TotalWeight); };
 	UFUNCTION(Category = "Inventory")
 	FORCEINLINE float GetWeightCapacity() const { return InventoryWeightCapacity;  };
 	UFUNCTION(Category = "Inventory")
 	FORCEINLINE int32 GetSlotsCapacity() const { return InventorySlotsCapacity; };
+	// Copies the stacks without the empty slots, prefer GetInventoryContentsView / GetNumItems from C++
 	UFUNCTION(Category = "Inventory")
-	FORCEINLINE TArray<UItemBase*> GetInventoryContents() const { return InventoryContents; };
+	TArray<UItemBase*> GetInventoryContents() const;
+	// Zero-copy access to the contents indexed by slot, empty slots are null. Valid until the inventory changes.
+	FORCEINLINE TConstArrayView<TObjectPtr<UItemBase>> GetInventoryContentsView() const { return InventoryContents; }
+	FORCEINLINE UItemBase* GetItemInSlot(const int32 Slot) const { return InventoryContents.IsValidIndex(Slot) ? InventoryContents[Slot].Get() : nullptr; }
+	// Number of stacks, not counting empty slots
+	FORCEINLINE int32 GetNumItems() const { return NumItems; }
+	FORCEINLINE bool IsEmpty() const { return NumItems == 0; }
+
+	// O(1) capacity queries, safe to use for server side validation as the totals are exact
+	FORCEINLINE const FInventoryAggregates& GetAggregates() const { return Aggregates; }
+	FORCEINLINE float GetWeightByType(const EItemType Type) const { return FInventoryAggregates::FromFixedWeight(Aggregates.WeightByType[static_cast<int32>(Type)]); }
+	FORCEINLINE float GetWeightByQuality(const EItemQuality Quality) const { return FInventoryAggregates::FromFixedWeight(Aggregates.WeightByQuality[static_cast<int32>(Quality)]); }
+	FORCEINLINE int32 GetQuantityByType(const EItemType Type) const { return Aggregates.QuantityByType[static_cast<int32>(Type)]; }
+	FORCEINLINE int32 GetQuantityByQuality(const EItemQuality Quality) const { return Aggregates.QuantityByQuality[static_cast<int32>(Quality)]; }
+	FORCEINLINE bool CanCarryAdditionalWeight(const float Weight) const { return Aggregates.TotalWeight + FInventoryAggregates::ToFixedWeight(Weight) <= GetFixedWeightCapacity(); }
 	
 	// Setters
 	UFUNCTION(Category = "Inventory")
@@ -116,17 +277,33 @@ protected:
 	// PROPERTIES & VARIABLES
 	//====================================================================================================================
 
-	UPROPERTY(VisibleAnywhere, Category = "Inventory")
-	float InventoryTotalWeight;
 	UPROPERTY(EditInstanceOnly, Category = "Inventory")
 	int32 InventorySlotsCapacity;
 	UPROPERTY(EditInstanceOnly, Category = "Inventory")
 	float InventoryWeightCapacity;
 
-	// Templated pointer array to store the inventory contents
+	// Inventory contents indexed by slot (UItemBase::SlotIndex). Removing a stack leaves a null hole instead of
+	// shifting every later stack down, so removal is O(1) and the slots the UI shows keep their stacks.
 	UPROPERTY(VisibleAnywhere, Category = "Inventory")
 	TArray<TObjectPtr<UItemBase>> InventoryContents;
+	// Holes in InventoryContents to reuse before growing it. Entries are dropped lazily when a stack is moved into
+	// the hole, so the free list may hold slots that were filled since, AcquireSlot skips those.
+	TArray<int32> FreeSlots;
+	int32 NumItems = 0;
+
+	FInventoryAggregates Aggregates;
+
+	// Stacks per item ID, lets partial stack lookups skip the linear scan of the contents.
+	// The items are kept alive by InventoryContents.
+	TMap<FName, TArray<UItemBase*, TInlineAllocator<2>>> StacksByID;
 
+	int32 UpdateBatchDepth = 0;
+	bool bPendingUpdateBroadcast = false;
+	// Bitsets and name index behind QueryItems, queries reuse its scratch buffers
+	mutable FInventoryQueryIndex QueryIndex;
+
+	// Accumulated until the next broadcast
+	FInventoryChangeSet PendingChangeSet;
 
 	//====================================================================================================================
 	// FUNCTIONS
@@ -137,8 +314,63 @@ protected:
 
 	FItemAddResult HandleNonStackableItems(UItemBase* InItem);
 	int32 HandleStackableItems(UItemBase* InItem, int32 AddAmount);
-	int32 CalculateWeightAddAmount(UItemBase* InItem, int32 AddAmount);
+	int32 CalculateWeightAddAmount(const UItemBase* InItem, int32 AddAmount) const;
 	int32 CalculateNumberForFullStack(UItemBase* StackableItem, int32 InitialAddAmount);
 
 	void AddNewItem(UItemBase* InItem, const int32 AddAmount);
+
+	// Adds an unowned item as a new stack / takes a stack out, keeping the aggregates and ID index up to date
+	void AttachItem(UItemBase* InItem);
+	void DetachItem(UItemBase* InItem);
+
+	// Free slot for a new stack, reusing a hole when there is one
+	int32 AcquireSlot();
+	// Grows InventoryContents with empty slots so Slot is valid
+	void EnsureSlot(const int32 Slot);
+	// Puts InItem (or nothing) in Slot, keeping SlotIndex, the query bitsets and the change set in sync
+	void PlaceInSlot(UItemBase* InItem, const int32 Slot);
+
+	// Moves AmountToTransfer (already clamped to what Destination accepts) without broadcasting or touching InventoryContents
+	void TransferAcceptedAmount(UItemBase* InItem, UCpp_AC_Inventory* Destination, const int32 AmountToTransfer);
+	// Merges Amount of Template into partial stacks then new stacks, ReusableItem becomes the last new stack if there is one
+	void ReceiveAmount(UItemBase* Template, const int32 Amount, UItemBase* ReusableItem);
+
+	// Called by UItemBase::SetQuantity so the totals follow every stack change no matter who made it
+	friend class UItemBase;
+	void UpdateItemQuantity(const UItemBase* Item, const int32 OldQuantity);
+
+	// Bulk commands, UCpp_InventorySimulationSubsystem runs the first half on a worker and the second on the game thread
+	friend class UCpp_InventorySimulationSubsystem;
+	// Only touches this inventory's existing stacks, aggregates and change set, anything else is left in the queue
+	void ExecuteCommands(FInventoryCommandQueue& Queue);
+	// Opens the pending stacks, recycles the emptied ones and broadcasts once
+	void ApplyCommandResults(FInventoryCommandQueue& Queue);
+	void ExecuteAddCommand(FInventoryCommandQueue& Queue, const FItemData& ItemData, const int32 Amount);
+	void ExecuteRemoveCommand(FInventoryCommandQueue& Queue, const FItemData& ItemData, const int32 Amount);
+
+	// Validates the aggregates (when enabled) and tells other classes the inventory has been updated
+	void NotifyInventoryUpdated();
+	void ValidateAggregates() const;
+
+	FORCEINLINE int64 GetFixedWeightCapacity() const { return FInventoryAggregates::ToFixedWeight(InventoryWeightCapacity); }
+};
+
+// Scoped batch, every OnInventoryUpdated raised on the inventory while it is alive collapses into a single broadcast
+struct FInventoryUpdateBatch {
+	explicit FInventoryUpdateBatch(UCpp_AC_Inventory* InInventory) : Inventory(InInventory) {
+		if (Inventory) {
+			Inventory->BeginUpdateBatch();
+		}
+	}
+	~FInventoryUpdateBatch() {
+		if (Inventory) {
+			Inventory->EndUpdateBatch();
+		}
+	}
+
+	FInventoryUpdateBatch(const FInventoryUpdateBatch&) = delete;
+	FInventoryUpdateBatch& operator=(const FInventoryUpdateBatch&) = delete;
+
+private:
+	UCpp_AC_Inventory* Inventory;
 };
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "../ItemDataStructs.h"
+#include "Utils/Cpp_TimerWheel.h"
+#include "Cpp_AC_ItemEffects.generated.h"
+
+class UItemBase;
+
+// Effect of using an item, taken from its statistics when it is used and applied with the rest of the frame's effects
+struct FItemEffectRecord {
+	FName ItemID;
+	// Per use
+	float Restoration;
+	float Damage;
+	// Uses of the same item in the same frame share a record
+	int32 Count;
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnHealthChanged, const float /*NewHealth*/, const float /*Delta*/);
+
+/**
+ * Applies the effects of used items to the owner. Uses only queue a record, the records are applied together
+ * in the next tick, and per item cooldowns are kept in a timer wheel instead of a timer per item.
+ * Ticks only while there are effects to apply or cooldowns running.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class CPP_INVENTORYSYSTEM_API UCpp_AC_ItemEffects : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	//====================================================================================================================
+	// PROPERTIES & VARIABLES
+	//====================================================================================================================
+	// Broadcast once per tick with the combined change of every effect applied in it
+	FOnHealthChanged OnHealthChanged;
+
+
+	//====================================================================================================================
+	// FUNCTIONS
+	//====================================================================================================================
+	UCpp_AC_ItemEffects();
+
+	// Uses up to Amount of Item, taking them out of its inventory. Items with a cooldown are used once per cooldown.
+	// Returns how many were used.
+	UFUNCTION(Category = "Item Effects")
+	int32 UseItem(UItemBase* Item, const int32 Amount = 1);
+
+	UFUNCTION(Category = "Item Effects")
+	bool CanUseItem(const UItemBase* Item) const;
+	UFUNCTION(Category = "Item Effects")
+	float GetCooldownRemaining(const FName ItemID) const;
+
+	// Getters
+	UFUNCTION(Category = "Item Effects")
+	FORCEINLINE float GetHealth() const { return Health; };
+	UFUNCTION(Category = "Item Effects")
+	FORCEINLINE float GetMaxHealth() const { return MaxHealth; };
+
+protected:
+	//====================================================================================================================
+	// PROPERTIES & VARIABLES
+	//====================================================================================================================
+
+	UPROPERTY(EditAnywhere, Category = "Item Effects")
+	float Health;
+	UPROPERTY(EditAnywhere, Category = "Item Effects")
+	float MaxHealth;
+
+	// Seconds before an item of the same ID can be used again, per item type (Weapon, Armor, Consumable, Spell, Quest, Other)
+	UPROPERTY(EditAnywhere, Category = "Item Effects", meta = (ClampMin = "0.0"))
+	float UseCooldownByType[NumItemTypes];
+
+	// Effects queued since the last tick
+	TArray<FItemEffectRecord, TInlineAllocator<8>> PendingEffects;
+
+	TCpp_TimerWheel<FName> CooldownWheel;
+	TMap<FName, FCpp_TimerWheelHandle> Cooldowns;
+
+	//====================================================================================================================
+	// FUNCTIONS
+	//====================================================================================================================
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	void ApplyPendingEffects();
+	void UpdateTickEnabled();
+};
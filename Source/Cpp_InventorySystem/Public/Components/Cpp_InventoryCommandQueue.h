@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCpp_AC_Inventory;
+class UItemBase;
+struct FItemData;
+
+enum class EInventoryCommandType : uint8 {
+	Add,
+	Remove
+};
+
+// One queued add or remove, the item data points into a data table that has to stay loaded until the commands ran
+struct FInventoryCommand {
+	EInventoryCommandType Type;
+	const FItemData* ItemData;
+	int32 Amount;
+};
+
+/**
+ * Commands queued for one inventory plus the side effects a worker can't apply itself.
+ * Filled on the game thread, run by a single worker, then applied back on the game thread.
+ */
+struct FInventoryCommandQueue {
+	// Amount of an item that needs new stacks, opened on the game thread as they need new UObjects
+	struct FPendingStacks {
+		const FItemData* ItemData;
+		int32 Amount;
+		int32 NumSlots;
+	};
+
+	TWeakObjectPtr<UCpp_AC_Inventory> Inventory;
+	TArray<FInventoryCommand> Commands;
+
+	// Written by the worker
+	TArray<FPendingStacks, TInlineAllocator<4>> PendingStacks;
+	// Stacks the commands emptied, detached and recycled on the game thread
+	TArray<UItemBase*> EmptiedStacks;
+	// Slots and fixed-point weight reserved by PendingStacks, so later commands in the queue see them as taken
+	int32 PendingSlots = 0;
+	int64 PendingWeight = 0;
+
+	int32 AmountAdded = 0;
+	int32 AmountRejected = 0;
+	int32 AmountRemoved = 0;
+
+	void ResetResults() {
+		PendingStacks.Reset();
+		EmptiedStacks.Reset();
+		PendingSlots = 0;
+		PendingWeight = 0;
+		AmountAdded = 0;
+		AmountRejected = 0;
+		AmountRemoved = 0;
+	}
+};
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../ItemDataStructs.h"
+#include "Cpp_InventoryQuery.generated.h"
+
+class UItemBase;
+
+UENUM(BlueprintType)
+enum class EItemStatistic : uint8 {
+	ArmorRating UMETA(DisplayName = "Armor Rating"),
+	DamageValue UMETA(DisplayName = "Damage Value"),
+	RestorationValue UMETA(DisplayName = "Restoration Value"),
+	SellValue UMETA(DisplayName = "Sell Value")
+};
+
+// Inclusive range one of the item statistics has to be in
+struct FItemStatisticRange {
+	EItemStatistic Statistic;
+	float Min;
+	float Max;
+};
+
+// Filter for UCpp_AC_Inventory::QueryItems, empty filters match everything
+struct CPP_INVENTORYSYSTEM_API FInventoryQuery {
+	// One bit per EItemType / EItemQuality value
+	uint32 TypeMask = 0;
+	uint32 QualityMask = 0;
+
+	TArray<FItemStatisticRange, TInlineAllocator<2>> StatisticRanges;
+
+	// Stored lower case, matched against the start of ItemTextData.ItemName
+	FString NamePrefix;
+
+	FInventoryQuery& WithType(const EItemType Type) {
+		TypeMask |= 1u << static_cast<uint32>(Type);
+		return *this;
+	}
+	FInventoryQuery& WithQuality(const EItemQuality Quality) {
+		QualityMask |= 1u << static_cast<uint32>(Quality);
+		return *this;
+	}
+	FInventoryQuery& WithStatisticRange(const EItemStatistic Statistic, const float Min, const float Max) {
+		StatisticRanges.Add({Statistic, Min, Max});
+		return *this;
+	}
+	FInventoryQuery& WithNamePrefix(const FString& Prefix) {
+		NamePrefix = Prefix.ToLower();
+		return *this;
+	}
+
+	// Checks the type, quality and statistic filters, the name is matched through the prefix index
+	bool MatchesItem(const UItemBase* Item) const;
+};
+
+/**
+ * Per-type and per-quality bitsets over the inventory slots plus a sorted name index,
+ * kept up to date by UCpp_AC_Inventory as stacks come and go.
+ */
+class CPP_INVENTORYSYSTEM_API FInventoryQueryIndex {
+public:
+	// Stack placed in Slot as it entered the inventory
+	void AddItem(UItemBase* Item, const int32 Slot);
+	// Stack moved into Slot, or Slot emptied, other slots keep their bits
+	void SetSlot(const UItemBase* Item, const int32 Slot);
+	void ClearSlot(const int32 Slot);
+	// Stack left the inventory, drops it from the name index
+	void RemoveName(const UItemBase* Item);
+	// Slots were compacted or reordered in bulk, the bitsets are rebuilt on the next query
+	FORCEINLINE void MarkSlotsDirty() { bSlotsDirty = true; }
+
+	void Reset();
+
+	// The returned view points into a buffer reused by the next query. Empty slots in Contents are skipped.
+	TConstArrayView<UItemBase*> Run(const FInventoryQuery& Query, TConstArrayView<TObjectPtr<UItemBase>> Contents);
+
+private:
+	struct FNameEntry {
+		FString Key;
+		UItemBase* Item;
+	};
+
+	void RebuildSlots(TConstArrayView<TObjectPtr<UItemBase>> Contents);
+	// ORs together the bitsets selected by Mask, or sets every slot when the mask is empty
+	void BuildMask(TBitArray<>& OutMask, const TBitArray<>* Bitsets, const int32 NumBitsets, const uint32 Mask, const int32 NumSlots) const;
+
+	TBitArray<> TypeBits[NumItemTypes];
+	TBitArray<> QualityBits[NumItemQualities];
+	bool bSlotsDirty = false;
+
+	// Sorted by lower case item name
+	TArray<FNameEntry> NameIndex;
+
+	// Scratch buffers kept between queries so steady state searches don't allocate
+	TBitArray<> TypeMaskBits;
+	TBitArray<> QualityMaskBits;
+	TArray<UItemBase*> Results;
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Containers/Ticker.h"
+
+class UItemBase;
+
+struct FItemPoolStats {
+	// Items that had to be created with NewObject
+	int32 NumCreated = 0;
+	// Acquires served from the pool
+	int32 NumReused = 0;
+	// Items handed back to the pool
+	int32 NumReleased = 0;
+	// Released items left to the garbage collector (pool full or not a transient item)
+	int32 NumDiscarded = 0;
+	// Items ready to be handed out / waiting for the end of the frame to become ready
+	int32 NumFree = 0;
+	int32 NumPendingRelease = 0;
+};
+
+/**
+ * Recycles the UItemBase copies created for splits, partial pickups and transfers so looting doesn't keep
+ * adding transient UObjects for the garbage collector to mark.
+ * Released items only become available again at the end of the frame, so widgets and callers still holding
+ * the pointer during the current operation never see it reused under them.
+ */
+class CPP_INVENTORYSYSTEM_API FCpp_ItemPool : public FGCObject {
+public:
+	static FCpp_ItemPool& Get();
+
+	virtual ~FCpp_ItemPool();
+
+	// Hands out a reset item from the pool, or a new one in the transient package
+	UItemBase* Acquire();
+	// Returns an item nothing should use anymore, only transient items are kept
+	void Release(UItemBase* Item);
+
+	FORCEINLINE const FItemPoolStats& GetStats() const { return Stats; }
+	void LogStats() const;
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	FCpp_ItemPool() = default;
+
+	bool ProcessPendingReleases(float DeltaTime);
+
+	static constexpr int32 MaxPooledItems = 1024;
+
+	TArray<TObjectPtr<UItemBase>> FreeItems;
+	TArray<TObjectPtr<UItemBase>> PendingReleases;
+	FTSTicker::FDelegateHandle PendingReleaseTickerHandle;
+	FItemPoolStats Stats;
+};
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "../ItemDataStructs.h"
+#include "Cpp_ItemCatalog.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UDataTable;
+
+/*
+ * Cooked item catalog layout (all values little endian, offsets relative to the start of the file):
+ *
+ *	[FItemCatalogHeader]
+ *	[FItemCatalogRecord * NumRecords]  sorted by IDHash so a row can be found with a binary search
+ *	[String Table]                     uint32 byte length followed by UTF-8 characters, one entry per referenced string
+ *
+ * The file is never deserialised, it is mapped read-only and rows are decoded one at a time on request,
+ * so the OS shares the pages between every server process on the same host that maps the same file.
+ */
+struct FItemCatalogHeader {
+	uint32 Magic;
+	uint32 Version;
+	uint32 NumRecords;
+	uint32 RecordsOffset;
+	uint32 StringTableOffset;
+	uint32 StringTableSize;
+};
+
+struct FItemCatalogRecord {
+	// Hash of the lower case ID, FName comparisons are case insensitive so the hash has to be too
+	uint64 IDHash;
+
+	// String table offsets
+	uint32 ID;
+	uint32 ItemName;
+	uint32 ItemDescription;
+	uint32 InteractionText;
+	uint32 UsageText;
+	uint32 IconPath;
+	uint32 MeshPath;
+
+	// FItemStatistics
+	float ArmorRating;
+	float DamageValue;
+	float RestorationValue;
+	float SellValue;
+
+	// FItemNumericData
+	int32 MaxStackSize;
+	int32 Weight;
+
+	uint8 ItemType;
+	uint8 ItemQuality;
+	uint8 bIsStackable;
+	uint8 Padding;
+};
+
+/**
+ * Read-only view over a cooked, memory-mapped item catalog.
+ */
+class CPP_INVENTORYSYSTEM_API FCpp_ItemCatalog {
+public:
+	static constexpr uint32 CatalogMagic = 0x54414349; // 'ICAT'
+	static constexpr uint32 CatalogVersion = 1;
+
+	FCpp_ItemCatalog();
+	~FCpp_ItemCatalog();
+
+	// Maps the catalog file, only the header is touched until rows are requested
+	bool Open(const FString& FilePath);
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return Records != nullptr; }
+	FORCEINLINE int32 Num() const { return NumRecords; }
+
+	// Binary search over the mapped records, returns nullptr when the ID is not in the catalog
+	const FItemCatalogRecord* FindRecord(const FName ID) const;
+
+	// Decodes a single row, asset references are only loaded when requested (dedicated servers don't need them)
+	bool FindItemData(const FName ID, FItemData& OutItemData, const bool bLoadAssets = true) const;
+
+	// Reads a string out of the string table
+	FString GetString(const uint32 Offset) const;
+
+	// Writes a catalog file from a data table of FItemData rows
+	static bool WriteCatalog(const UDataTable* ItemTable, const FString& FilePath);
+
+	static uint64 HashID(const FName ID);
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const FItemCatalogRecord* Records;
+	const uint8* StringTable;
+	uint32 StringTableSize;
+	int32 NumRecords;
+};
+
+/**
+ * Owns the process wide item catalog mapping.
+ * The catalog must be staged as a loose file (DirectoriesToAlwaysStageAsNonUFS) for it to be mappable in packaged builds.
+ */
+UCLASS(Config = Game)
+class CPP_INVENTORYSYSTEM_API UCpp_ItemCatalogSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	FORCEINLINE const FCpp_ItemCatalog& GetCatalog() const { return Catalog; }
+	FORCEINLINE bool IsCatalogLoaded() const { return Catalog.IsOpen(); }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	// Path of the cooked catalog relative to the project content directory
+	UPROPERTY(Config)
+	FString CatalogPath = TEXT("Catalog/Items.icat");
+
+	FCpp_ItemCatalog Catalog;
+};
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Styling/SlateBrush.h"
+#include "Cpp_ItemIconAtlas.generated.h"
+
+class UTexture2D;
+class UImage;
+class UItemBase;
+
+// Where an item's icon was packed
+USTRUCT()
+struct FItemIconAtlasEntry {
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Icon Atlas")
+	int32 Page = 0;
+
+	// Normalized region of the page, the padding around the icon is left out
+	UPROPERTY(VisibleAnywhere, Category = "Icon Atlas")
+	FVector2D UVMin = FVector2D::ZeroVector;
+	UPROPERTY(VisibleAnywhere, Category = "Icon Atlas")
+	FVector2D UVMax = FVector2D::UnitVector;
+};
+
+/**
+ * Every item icon packed into a few large textures, written by the Cpp_PackItemIconAtlas commandlet.
+ * Slots showing icons of the same page share one texture, so Slate draws a whole grid of them in a single batch
+ * instead of one batch per icon texture.
+ */
+UCLASS(BlueprintType)
+class CPP_INVENTORYSYSTEM_API UCpp_ItemIconAtlas : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Brush showing only the item's region of its page, nullptr for items that weren't packed.
+	// The brushes are built once for the whole atlas and stay valid for its lifetime.
+	const FSlateBrush* FindIconBrush(const FName ItemID) const;
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+	FORCEINLINE int32 GetNumPages() const { return Pages.Num(); }
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	// Replaces the contents with a freshly packed atlas
+	void SetPackedContents(const int32 InIconSize, TArray<TObjectPtr<UTexture2D>>&& InPages, TMap<FName, FItemIconAtlasEntry>&& InEntries);
+#endif
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	// Size in pixels every icon was packed at
+	UPROPERTY(VisibleAnywhere, Category = "Icon Atlas")
+	int32 IconSize = 128;
+
+	UPROPERTY(VisibleAnywhere, Category = "Icon Atlas")
+	TArray<TObjectPtr<UTexture2D>> Pages;
+
+	UPROPERTY(VisibleAnywhere, Category = "Icon Atlas")
+	TMap<FName, FItemIconAtlasEntry> Entries;
+
+	// One brush per entry, never added to after being built so the returned pointers stay put
+	mutable TMap<FName, FSlateBrush> Brushes;
+	// Set by PostLoad and SetPackedContents, entries without a valid page have no brush so the counts can differ
+	mutable bool bBrushesBuilt = false;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	void BuildBrushes() const;
+};
+
+/**
+ * Loads the configured icon atlas and hands item icons to image widgets, falling back to the item's own icon
+ * texture when there is no atlas or the item isn't in it.
+ */
+UCLASS(Config = Game)
+class CPP_INVENTORYSYSTEM_API UCpp_ItemIconSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Shows Item's icon in Image through the atlas of Image's game instance when there is one
+	static void SetItemIcon(UImage* Image, const UItemBase* Item);
+
+	FORCEINLINE const UCpp_ItemIconAtlas* GetIconAtlas() const { return IconAtlas; }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<UCpp_ItemIconAtlas> IconAtlasAsset;
+
+	UPROPERTY(Transient)
+	UCpp_ItemIconAtlas* IconAtlas;
+};
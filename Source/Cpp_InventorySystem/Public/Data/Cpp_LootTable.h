@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/DataTable.h"
+#include "../ItemDataStructs.h"
+#include "Cpp_LootTable.generated.h"
+
+class UCpp_AC_Inventory;
+class UCpp_LootTable;
+
+USTRUCT()
+struct FLootTableEntry {
+	GENERATED_BODY()
+
+	// Item dropped by this entry, ignored when a nested table is set
+	UPROPERTY(EditAnywhere, Category = "Loot")
+	FDataTableRowHandle ItemRowHandle;
+
+	// Rolls this table instead of dropping an item
+	UPROPERTY(EditAnywhere, Category = "Loot")
+	TObjectPtr<UCpp_LootTable> NestedTable;
+
+	// Relative chance of this entry, scaled by the quality weight of its item
+	UPROPERTY(EditAnywhere, Category = "Loot", meta = (ClampMin = "0.0"))
+	float Weight = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Loot", meta = (ClampMin = "1"))
+	int32 MinQuantity = 1;
+
+	UPROPERTY(EditAnywhere, Category = "Loot", meta = (ClampMin = "1"))
+	int32 MaxQuantity = 1;
+};
+
+// Result of a roll, the item data points into the data table so the table has to stay loaded
+struct FLootDrop {
+	const FItemData* ItemData;
+	int32 Quantity;
+};
+
+// Walker / Vose alias table, O(1) weighted sampling after an O(n) build
+struct CPP_INVENTORYSYSTEM_API FLootAliasTable {
+	void Build(TConstArrayView<float> Weights);
+	int32 Sample(const FRandomStream& RandomStream) const;
+
+	FORCEINLINE bool IsEmpty() const { return Probabilities.IsEmpty(); }
+
+private:
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+};
+
+/**
+ * Weighted loot table, every roll is deterministic for a given seed.
+ * Sampling tables are built once when the asset loads so bulk rolls only do the sampling itself.
+ */
+UCLASS(BlueprintType)
+class CPP_INVENTORYSYSTEM_API UCpp_LootTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	UPROPERTY(EditAnywhere, Category = "Loot")
+	TArray<FLootTableEntry> Entries;
+
+	// Multiplies the weight of every item entry by the weight of the item's quality (Common, Uncommon, Rare, Epic, Legendary)
+	UPROPERTY(EditAnywhere, Category = "Loot", meta = (ClampMin = "0.0"))
+	float QualityWeights[NumItemQualities];
+
+	// Number of entries rolled each time the table is rolled
+	UPROPERTY(EditAnywhere, Category = "Loot", meta = (ClampMin = "0"))
+	int32 MinRolls = 1;
+
+	UPROPERTY(EditAnywhere, Category = "Loot", meta = (ClampMin = "0"))
+	int32 MaxRolls = 1;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	UCpp_LootTable();
+
+	// Appends the drops of one roll of this table to OutDrops. OutDrops is never emptied here so callers can
+	// reuse a preallocated buffer across thousands of rolls.
+	void RollDrops(FRandomStream& RandomStream, TArray<FLootDrop>& OutDrops) const;
+
+	// Rolls the table from Seed and adds the drops to Inventory with a single broadcast, returns the amount added
+	int32 RollIntoInventory(const int32 Seed, UCpp_AC_Inventory* Inventory) const;
+
+	// Rolls the table from Seed and spawns a pickup per drop, scattered around Origin
+	void SpawnPickups(UWorld* World, const int32 Seed, const FTransform& Origin, const float ScatterRadius = 50.0f) const;
+
+	// Resolves the item rows and builds the sampling table. Done on load and edit, call it after filling the entries
+	// of a table created at runtime, rolls never build it themselves.
+	void BuildSamplingTable();
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	// Nested tables deeper than this are ignored so a table that contains itself can't recurse forever
+	static constexpr int32 MaxNestingDepth = 8;
+
+	FLootAliasTable AliasTable;
+	// Item rows of the entries resolved once, nullptr for nested tables and missing rows.
+	// They point into the data tables, so editing or reimporting one of those in the editor resolves them again.
+	TArray<const FItemData*> ResolvedItems;
+
+#if WITH_EDITORONLY_DATA
+	TArray<TWeakObjectPtr<UDataTable>> WatchedDataTables;
+#endif
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	void RollDrops(FRandomStream& RandomStream, TArray<FLootDrop>& OutDrops, const int32 Depth) const;
+#if WITH_EDITOR
+	void UnwatchDataTables();
+	void HandleItemDataTableChanged();
+#endif
+};
@@ -25,6 +25,10 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "Item Data")
 		UCpp_AC_Inventory* OwningInventory;
 
+	// Slot of the stack in OwningInventory, stays put while other stacks come and go. INDEX_NONE outside an inventory.
+	UPROPERTY(VisibleAnywhere, Category = "Item Data")
+	int32 SlotIndex;
+
 	// UiMin and UiMax are used to min and max the value of the Quantity
 	UPROPERTY(VisibleAnywhere, Category="Item")
 	int32 Quantity;
@@ -63,15 +67,21 @@ public:
 	UItemBase();
 
 	UItemBase* CreateItemCopy();
+
+	// Copies the static row data (type, stats, text, assets) of an item definition into this item
+	void InitializeFromItemData(const FItemData& ItemData);
 	
 	void ResetItemFlags();
 
+	// Clears the item back to its freshly constructed state so FCpp_ItemPool can hand it out again
+	void ResetForReuse();
+
 	// Getters
 	UFUNCTION(Category = "Item")
-	FORCEINLINE float GetItemStackWeight() { return Quantity * ItemNumericData.Weight; };
+	FORCEINLINE float GetItemStackWeight() const { return Quantity * ItemNumericData.Weight; };
 
 	UFUNCTION(Category = "Item")
-	FORCEINLINE float GetItemSingleWeight() { return ItemNumericData.Weight; };
+	FORCEINLINE float GetItemSingleWeight() const { return ItemNumericData.Weight; };
 
 	UFUNCTION(Category = "Item")
 	FORCEINLINE bool IsFullItemStack() const { return Quantity == ItemNumericData.MaxStackSize; };
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Cpp_FocusHighlightSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Owns the focus outline (custom depth and stencil) of every interactable in the world.
+ * BeginFocus/EndFocus only record what is wanted, the render state is changed at most once per component per frame,
+ * and a highlight is held for a short release delay so a target the interaction trace loses for a check or two
+ * keeps its outline instead of having its render state recreated on every flicker.
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_FocusHighlightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Routes through the subsystem of the component's world, or toggles custom depth right away when there is none (editor preview)
+	static void SetFocusHighlight(UPrimitiveComponent* Component, const bool bHighlighted, const int32 StencilValue = INDEX_NONE);
+
+	// StencilValue is written together with custom depth when it isn't INDEX_NONE
+	void RequestHighlight(UPrimitiveComponent* Component, const int32 StencilValue = INDEX_NONE);
+	void ReleaseHighlight(UPrimitiveComponent* Component);
+
+	FORCEINLINE bool IsHighlighted(UPrimitiveComponent* Component) const {
+		const FHighlightState* State = Highlights.Find(Component);
+		return State && State->bApplied;
+	}
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return NumUnsettled > 0; }
+
+	virtual void Deinitialize() override;
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	struct FHighlightState {
+		// Set by focus, what the render state will end up as once the release delay ran out
+		bool bWanted = false;
+		// What the render state currently is
+		bool bApplied = false;
+		int32 StencilValue = INDEX_NONE;
+		// World time the highlight may be removed at, after losing focus
+		double ReleaseTime = 0.0;
+	};
+
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, FHighlightState> Highlights;
+	// Entries whose render state doesn't match what is wanted yet, the subsystem only ticks while there are any
+	int32 NumUnsettled = 0;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	static void ApplyHighlight(UPrimitiveComponent* Component, const bool bHighlighted, const int32 StencilValue);
+
+	void RecountUnsettled();
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Utils/Cpp_TimerWheel.h"
+#include "Cpp_InteractionTimerSubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOnInteractionProgress, const float /*Progress*/);
+
+/**
+ * Times every duration based interaction in the world (containers, devices, channelled pickups) on one timer wheel.
+ * Starting, cancelling and completing an interaction is O(1) however many are running, and the subsystem
+ * doesn't tick at all while none are.
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_InteractionTimerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	UCpp_InteractionTimerSubsystem();
+
+	// OnCompleted runs once Duration has passed unless the interaction is cancelled first.
+	// OnProgress, if bound, is pushed the progress on every tick it changed, ending with 1 right before OnCompleted.
+	FCpp_TimerWheelHandle StartInteraction(const float Duration, FSimpleDelegate OnCompleted, FOnInteractionProgress OnProgress = FOnInteractionProgress());
+	// Returns false if the interaction already completed or was cancelled, Handle is invalidated either way
+	bool CancelInteraction(FCpp_TimerWheelHandle& Handle);
+
+	FORCEINLINE bool IsInteractionActive(const FCpp_TimerWheelHandle& Handle) const { return InteractionTimers.IsActive(Handle); }
+	// 0 when the interaction starts, 1 when it completes
+	FORCEINLINE float GetInteractionProgress(const FCpp_TimerWheelHandle& Handle) const { return InteractionTimers.GetElapsedFraction(Handle); }
+	FORCEINLINE float GetInteractionTimeRemaining(const FCpp_TimerWheelHandle& Handle) const { return InteractionTimers.GetRemainingTime(Handle); }
+	FORCEINLINE int32 GetNumActiveInteractions() const { return InteractionTimers.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !InteractionTimers.IsEmpty(); }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	struct FWatchedInteraction {
+		FCpp_TimerWheelHandle Handle;
+		FOnInteractionProgress OnProgress;
+		float LastProgress;
+	};
+
+	TCpp_TimerWheel<FSimpleDelegate> InteractionTimers;
+	// Interactions something displays, usually just the local player's, the rest never compute their progress
+	TArray<FWatchedInteraction> WatchedInteractions;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	void RemoveWatchedInteraction(const FCpp_TimerWheelHandle& Handle, const bool bCompleted);
+};
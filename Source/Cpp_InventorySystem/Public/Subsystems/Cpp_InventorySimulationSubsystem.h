@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Components/Cpp_InventoryCommandQueue.h"
+#include "Cpp_InventorySimulationSubsystem.generated.h"
+
+class UCpp_AC_Inventory;
+struct FItemData;
+
+/**
+ * Runs bulk add / remove commands for many inventories at once (eg. NPC economies on the server).
+ * Commands are queued per inventory and executed once per tick, each inventory's queue on its own worker,
+ * then the new stacks, recycled stacks and broadcasts are applied back on the game thread.
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_InventorySimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// ItemData has to stay valid until the next tick. Results are broadcast by the inventory as usual.
+	void QueueAdd(UCpp_AC_Inventory* Inventory, const FItemData& ItemData, const int32 Amount);
+	void QueueRemove(UCpp_AC_Inventory* Inventory, const FItemData& ItemData, const int32 Amount);
+
+	// Runs every queued command now instead of waiting for the tick, including commands queued by the update listeners
+	void FlushCommands();
+
+	FORCEINLINE int32 GetNumQueuedInventories() const { return Queues.Num(); }
+
+	// Runs the same random commands on NumInventories transient inventories single threaded and in parallel, logs both timings
+	static void RunBenchmark(const int32 NumInventories, const int32 CommandsPerInventory);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !Queues.IsEmpty(); }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	TArray<FInventoryCommandQueue> Queues;
+	TMap<TObjectKey<UCpp_AC_Inventory>, int32> QueueIndices;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	FInventoryCommandQueue& FindOrAddQueue(UCpp_AC_Inventory* Inventory);
+
+	// Worker pass then game thread pass over Queues
+	static void ExecuteQueues(TArrayView<FInventoryCommandQueue> InQueues, const bool bParallel);
+};
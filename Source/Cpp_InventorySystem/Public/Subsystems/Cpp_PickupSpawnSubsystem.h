@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Cpp_PickupSpawnSubsystem.generated.h"
+
+class APickup;
+class UItemBase;
+
+// A pickup waiting to be spawned (Item set) or a placed pickup waiting to be initialized (Pickup set)
+USTRUCT()
+struct FPendingPickupWork {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<APickup> Pickup;
+
+	// Kept alive by the subsystem until the pickup holding it is spawned
+	UPROPERTY()
+	TObjectPtr<UItemBase> Item;
+
+	int32 Quantity = 0;
+	FTransform Transform;
+	TWeakObjectPtr<AActor> Owner;
+
+	// To the closest player, refreshed whenever the queue is sorted
+	double DistanceSquared = 0.0;
+};
+
+/**
+ * Spawns dropped pickups and initializes placed ones within a per-frame time budget instead of all at once.
+ * A streamed in level full of loot or a large loot roll used to initialize every pickup in the frame it arrived,
+ * now the work is spread over as many frames as it takes, closest to a player first. Placed pickups within
+ * Inventory.PickupSpawn.ImmediateRadius of a player don't wait for the budget, they could be aimed at already.
+ * "stat Inventory" shows the queue depth and the time spent per frame.
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_PickupSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Spawns a pickup holding Quantity of Item, through the queue of World when there is one and right away otherwise
+	static void SpawnDrop(UWorld* World, UItemBase* Item, const int32 Quantity, const FTransform& Transform, AActor* Owner = nullptr);
+	// Called from BeginPlay of placed pickups, initializes Pickup through the queue of its world when there is one
+	static void InitializePlacedPickup(APickup* Pickup);
+
+	FORCEINLINE int32 GetQueueDepth() const { return PendingWork.Num(); }
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !PendingWork.IsEmpty(); }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	// Sorted by distance with the closest entry last, so the next one to do is popped off the end
+	UPROPERTY()
+	TArray<FPendingPickupWork> PendingWork;
+
+	// Entries were added since the last sort
+	bool bNeedsSort = false;
+	double LastSortTime = 0.0;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	static bool IsQueueEnabled();
+	static void SpawnDropNow(UWorld* World, UItemBase* Item, const int32 Quantity, const FTransform& Transform, AActor* Owner);
+	static void InitializePickupNow(APickup* Pickup);
+
+	void GatherPlayerLocations(TArray<FVector, TInlineAllocator<4>>& OutPlayerLocations) const;
+	// Placed pickups near a player skip the budget, they have to be there before the player can aim at them.
+	// Pops them off the sorted tail, never walks the whole queue.
+	void InitializePickupsNearPlayers(TConstArrayView<FVector> PlayerLocations);
+	void SortByDistanceToPlayers(TConstArrayView<FVector> PlayerLocations);
+};
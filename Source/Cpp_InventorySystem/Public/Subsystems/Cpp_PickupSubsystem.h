@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Utils/Cpp_SpatialHashGrid.h"
+#include "Cpp_PickupSubsystem.generated.h"
+
+class APickup;
+
+/**
+ * Keeps every initialized pickup of the world in a spatial hash grid and consolidates dropped stacks.
+ * A dropped pickup is queued and, once it had time to settle, merged into a nearby pickup of the same stackable item
+ * without going over MaxStackSize. The queue is worked off within a per-frame time budget, so a mass drop never
+ * costs more than the budget in a single frame however many pickups it spawned.
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_PickupSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Adds Pickup to the grid, calling it again only refreshes its cell. With bMergeNearby (drops) it is queued to be merged
+	// into a nearby stack, level placed pickups are only merge targets so designers' placements stay as they are.
+	void RegisterPickup(APickup* Pickup, const bool bMergeNearby);
+	void UnregisterPickup(APickup* Pickup);
+
+	FORCEINLINE int32 GetNumPickups() const { return Pickups.Num(); }
+	FORCEINLINE int32 GetNumPendingMerges() const { return PendingMerges.Num() - PendingMergesHead; }
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return GetNumPendingMerges() > 0; }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	struct FPendingMerge {
+		TWeakObjectPtr<APickup> Pickup;
+		// World time the pickup is merged at, dropped pickups get to land first
+		double ReadyTime = 0.0;
+	};
+
+	// Pickups only leave the grid in EndPlay, before they are destroyed, so the raw pointers never dangle
+	TCpp_SpatialHashGrid<APickup*> Grid;
+	// Cell each pickup was last put in, pickups simulate physics so it is refreshed whenever a pickup is looked at
+	TMap<APickup*, FIntPoint> Pickups;
+
+	// FIFO, drops all get the same delay so it is sorted by ReadyTime except for leftovers queued again right away,
+	// those wait behind the drops at most one delay. Consumed entries are only removed in bulk.
+	TArray<FPendingMerge> PendingMerges;
+	int32 PendingMergesHead = 0;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Merges Pickup into the fullest nearby stack with room, returns true if anything was moved
+	bool MergeIntoNearbyStack(APickup* Pickup);
+};
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "Cpp_SignificanceSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+// How much detail a world item gets, from full fidelity down to not drawn at all
+enum class ESignificanceBucket : uint8 {
+	// Simulates physics, blocks and casts shadows as set up
+	Near,
+	// At rest, only answers queries and casts no shadow
+	Mid,
+	// No collision at all
+	Far,
+	// Far and hidden, only beyond Inventory.Significance.CullDistance
+	Culled,
+	Num
+};
+
+/**
+ * Buckets pickups and interactables by their distance to the players' views and turns off what nobody can notice:
+ * physics simulation, physics collision, shadows and at last drawing. Near buckets get everything back as it was set up.
+ * Distances are scaled by the view distance scalability level, items behind every view count as further away,
+ * and an item has to move a bit past a threshold to change bucket so it doesn't flip back and forth on the line.
+ * Items are looked at round robin, a fixed number per frame however many there are, and only bucket changes touch
+ * the components. "stat Inventory" shows the bucket populations.
+ */
+UCLASS()
+class CPP_INVENTORYSYSTEM_API UCpp_SignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Primitive is the component the bucket settings apply to, its current settings are what Near restores
+	static void RegisterItem(AActor* Owner, UPrimitiveComponent* Primitive);
+	static void UnregisterItem(AActor* Owner);
+
+	FORCEINLINE int32 GetBucketPopulation(const ESignificanceBucket Bucket) const { return BucketPopulations[static_cast<int32>(Bucket)]; }
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !Items.IsEmpty(); }
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	struct FSignificanceItem {
+		AActor* Owner = nullptr;
+		TWeakObjectPtr<UPrimitiveComponent> Primitive;
+		ESignificanceBucket Bucket = ESignificanceBucket::Near;
+
+		// Restored when the item comes back to Near
+		ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+		bool bSimulatePhysics = false;
+		bool bCastShadow = true;
+	};
+
+	struct FViewPoint {
+		FVector Location;
+		FVector Direction;
+	};
+
+	// Owners only leave in EndPlay, before they are destroyed, so the raw pointers never dangle
+	TArray<FSignificanceItem> Items;
+	TMap<AActor*, int32> ItemIndices;
+	// Next item the round robin looks at
+	int32 NextItem = 0;
+
+	int32 BucketPopulations[static_cast<int32>(ESignificanceBucket::Num)] = {};
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	void AddItem(AActor* Owner, UPrimitiveComponent* Primitive);
+	void RemoveItem(AActor* Owner);
+
+	void GatherViewPoints(TArray<FViewPoint, TInlineAllocator<4>>& OutViewPoints) const;
+	static ESignificanceBucket CalculateBucket(const FSignificanceItem& Item, TConstArrayView<FViewPoint> ViewPoints, const float DistanceScale);
+	// Returns false if the change has to wait, a body still moving isn't frozen in place
+	static bool ApplyBucket(FSignificanceItem& Item, const ESignificanceBucket NewBucket);
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/TextBlock.h"
+
+// Number formats shared by every widget, built once instead of per SetText
+namespace Cpp_TextFormatting {
+	// Up to two decimals and no grouping, "12.5" instead of "12.500000"
+	inline const FNumberFormattingOptions& GetDecimalOptions() {
+		static const FNumberFormattingOptions Options = FNumberFormattingOptions().SetUseGrouping(false).SetMaximumFractionalDigits(2);
+		return Options;
+	}
+	// Whole numbers without grouping, for quantities and stack sizes
+	inline const FNumberFormattingOptions& GetIntegerOptions() {
+		static const FNumberFormattingOptions Options = FNumberFormattingOptions().SetUseGrouping(false).SetMaximumFractionalDigits(0);
+		return Options;
+	}
+}
+
+/**
+ * Text block that remembers the text it shows, SetText is only forwarded when the text differs.
+ * Every forwarded SetText invalidates the block's layout, unchanged texts cost a string compare instead.
+ */
+class FCpp_CachedText {
+public:
+	// Forgets the cached text so the next Set always reaches the block
+	void Bind(UTextBlock* InTextBlock) {
+		TextBlock = InTextBlock;
+		bHasText = false;
+	}
+	FORCEINLINE void Invalidate() { bHasText = false; }
+
+	// Returns true if the block was updated
+	bool Set(const FText& Text) {
+		if (!TextBlock || (bHasText && (LastText.IdenticalTo(Text) || LastText.ToString().Equals(Text.ToString(), ESearchCase::CaseSensitive)))) {
+			return false;
+		}
+		LastText = Text;
+		bHasText = true;
+		TextBlock->SetText(Text);
+		return true;
+	}
+
+private:
+	UTextBlock* TextBlock = nullptr;
+	FText LastText;
+	bool bHasText = false;
+};
+
+/**
+ * Text block showing a value (number, pair of numbers...) that is formatted by the caller.
+ * The value is compared before anything is formatted, so an unchanged value builds no FText or FString at all.
+ */
+template<typename ValueType>
+class TCpp_CachedValueText {
+public:
+	void Bind(UTextBlock* InTextBlock) {
+		TextBlock = InTextBlock;
+		LastValue.Reset();
+	}
+	FORCEINLINE void Invalidate() { LastValue.Reset(); }
+
+	// Format(Value) returns the FText to show, it is only called when Value changed. Returns true if the block was updated.
+	template<typename FormatFuncType>
+	bool Set(const ValueType& Value, FormatFuncType&& Format) {
+		if (!TextBlock || (LastValue.IsSet() && LastValue.GetValue() == Value)) {
+			return false;
+		}
+		LastValue = Value;
+		TextBlock->SetText(Format(Value));
+		return true;
+	}
+
+private:
+	UTextBlock* TextBlock = nullptr;
+	TOptional<ValueType> LastValue;
+};
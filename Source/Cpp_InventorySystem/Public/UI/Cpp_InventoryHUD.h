@@ -13,6 +13,9 @@
 // Forward Declaration
 class UCpp_WGT_MainMenu;
 class UCpp_WGT_Interaction;
+class UCpp_WGT_DragItem;
+class UCpp_ItemDragDropOperation;
+class UItemBase;
 struct FInteractableData;
 
 
@@ -36,6 +39,17 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Widgets")
 	TSubclassOf<UUserWidget> CrosshairClass;
 
+	// Builds the widgets one per frame after BeginPlay instead of on first use, skipping frames slower than PrewarmMaxFrameTime
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets")
+	bool bPrewarmWidgets = true;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets", meta = (EditCondition = "bPrewarmWidgets", ClampMin = "0.0"))
+	float PrewarmMaxFrameTime = 1.0f / 30.0f;
+
+	// Seconds the main menu may stay closed before it is destroyed and its memory given back, 0 keeps it forever
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets", meta = (ClampMin = "0.0"))
+	float MainMenuReleaseDelay = 60.0f;
+
 	bool bIsMenuVisible = false;
 
 
@@ -55,6 +69,11 @@ public:
 	void ShowInteractionWidget();
 	void HideInteractionWidget();
 	void UpdateInteractionWidget(const FInteractableData* InteractableData);
+	void UpdateInteractionProgress(const float Progress);
+
+	// Rebinds the HUD's one drag visual and drag operation to Item, only one drag can be running at a time so every
+	// inventory drag shares them and dragging creates no objects. The visual is recreated only if DragVisualClass differs.
+	UCpp_ItemDragDropOperation* BeginItemDrag(const TSubclassOf<UCpp_WGT_DragItem> DragVisualClass, UItemBase* Item, const FLinearColor& BorderColor);
 
 protected:
 	//=========================================================================================================================
@@ -70,10 +89,28 @@ protected:
 	UPROPERTY()
 	UUserWidget* CrosshairWidget;
 
+	UPROPERTY()
+	UCpp_WGT_DragItem* DragVisual;
+
+	UPROPERTY()
+	UCpp_ItemDragDropOperation* DragOperation;
+
+	FTimerHandle MainMenuReleaseTimer;
+	// Next widget to prewarm, see PrewarmNextWidget
+	int32 PrewarmStep = 0;
+
 	//=========================================================================================================================
 	// FUNCTIONS
 	//=========================================================================================================================
 
 	virtual void BeginPlay() override;
 
+	// Widgets are only created the first time something needs them
+	UCpp_WGT_MainMenu* GetOrCreateMainMenu();
+	UCpp_WGT_Interaction* GetOrCreateInteractionWidget();
+	UUserWidget* GetOrCreateCrosshair();
+
+	void PrewarmNextWidget();
+	void ReleaseMainMenu();
+
 };
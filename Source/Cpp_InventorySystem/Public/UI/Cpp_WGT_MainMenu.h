@@ -6,6 +6,9 @@
 
 // Forward declaration
 class ACpp_InventorySystemCharacter; 
+class UCpp_WGT_InventoryPanel;
+class URetainerBox;
+class UInvalidationBox;
 
 UCLASS()
 class CPP_INVENTORYSYSTEM_API UCpp_WGT_MainMenu : public UUserWidget {
@@ -14,7 +17,23 @@ public:
 	UPROPERTY()
 		ACpp_InventorySystemCharacter* PlayerCharacter;
 
+	// Called by the HUD when the menu is shown / hidden, a closed menu neither rebuilds nor re-renders
+	void SetMenuOpen(const bool bOpen);
+	// Something inside the menu changed, the cached render has to be redrawn
+	void NotifyContentChanged() const;
+
 protected:
+	// Optional, caches the rendered menu so static frames only draw a texture
+	UPROPERTY(meta = (BindWidgetOptional))
+	URetainerBox* RB_MenuCache;
+
+	// Optional, caches the slot widgets' layout and draw elements until a slot invalidates
+	UPROPERTY(meta = (BindWidgetOptional))
+	UInvalidationBox* IB_Inventory;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UCpp_WGT_InventoryPanel* WGT_InventoryPanel;
+
 	virtual void NativeConstruct() override;
 	virtual void NativeOnInitialized() override;
 	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "UI/Cpp_CachedText.h"
 #include "Cpp_WGT_Interaction.generated.h"
 
 
@@ -24,6 +25,9 @@ public:
 
 	void UpdateWidget(const FInteractableData* InteractableData);
 
+	// Pushed by the interaction timer while a timed interaction runs, the bar is only touched when the value changes
+	void SetInteractionProgress(const float Progress);
+
 protected:
 	UPROPERTY(VisibleAnywhere, meta = (BindWidget), Category = "Interaction Widget | Interactable Data")
 	UTextBlock* TXT_Name;
@@ -43,11 +47,17 @@ protected:
 	UPROPERTY(VisibleAnywhere, meta = (BindWidget), Category = "Interaction Widget | Interactable Data")
 	float CurrentInteractionDuration;
 
-	UFUNCTION(Category = "Interaction Widget | Interactable Data")
-	float UpdateInteractionProgress();
+	// Last value given to PB_Interaction
+	float CurrentInteractionProgress;
+
+	// UpdateWidget runs on every focus change, usually with the same texts as last time
+	FCpp_CachedText NameText;
+	FCpp_CachedText ActionText;
+	FCpp_CachedText KeyPressText;
+	TCpp_CachedValueText<int32> QuantityText;
 
 
-	virtual void NativeConstruct() override;
 	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
 
 };
@@ -15,6 +15,9 @@ class CPP_INVENTORYSYSTEM_API UCpp_ItemDragDropOperation : public UDragDropOpera
 	GENERATED_BODY()
 	
 public:
+	// Points the operation at a new drag, the HUD reuses one operation for every inventory drag
+	void SetDraggedItem(UItemBase* Item, UWidget* DragVisual);
+
 	UPROPERTY()
 	UItemBase* SourceItem;
 	
@@ -4,12 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "UI/Cpp_CachedText.h"
 #include "Cpp_WGT_DragItem.generated.h"
 
 // Forward Declarations
 class UBorder;
 class UImage;
 class UTextBlock;
+class UItemBase;
 
 UCLASS()
 class CPP_INVENTORYSYSTEM_API UCpp_WGT_DragItem : public UUserWidget
@@ -17,6 +19,9 @@ class CPP_INVENTORYSYSTEM_API UCpp_WGT_DragItem : public UUserWidget
 	GENERATED_BODY()
 
 public:
+	// Shows Item, the HUD reuses one drag visual for every drag
+	void SetDraggedItem(const UItemBase* Item, const FLinearColor& BorderColor);
+
 	UPROPERTY(VisibleAnywhere, Category = "Drag Item", meta = (BindWidget))
 	UBorder* Border_Item;
 	
@@ -25,4 +30,10 @@ public:
 
 	UPROPERTY(VisibleAnywhere, Category = "Drag Item", meta = (BindWidget))
 	UTextBlock* TXT_Quantity;
+
+protected:
+	// Dragging the same stack again doesn't touch the text
+	TCpp_CachedValueText<int32> QuantityText;
+
+	virtual void NativeOnInitialized() override;
 };
@@ -8,6 +8,7 @@
 
 // Forward Declarations
 class UItemBase;
+class UCpp_AC_Inventory;
 class UCpp_WGT_DragItem;
 class UCpp_WGT_InventoryToolTip;
 class UBorder;
@@ -25,6 +26,16 @@ class CPP_INVENTORYSYSTEM_API UCpp_WGT_InventoryItemSlot : public UUserWidget
 public:
 	FORCEINLINE void SetItemReference(UItemBase* InItem) { ItemReference = InItem; };
 	FORCEINLINE UItemBase* GetItemReference() const { return ItemReference; };
+	// The inventory slot the widget stands for, empty slots are drop targets too
+	FORCEINLINE void SetInventorySlot(UCpp_AC_Inventory* InInventory, const int32 InSlotIndex) { InventoryReference = InInventory; SlotIndex = InSlotIndex; };
+	FORCEINLINE int32 GetSlotIndex() const { return SlotIndex; };
+
+	// Updates the whole slot from ItemReference, for slot widgets that are reused for another stack
+	void RefreshSlot();
+	// Updates the quantity text only, and only if the quantity changed
+	void RefreshQuantity();
+	// False once the slot's item was recycled into a different item, even if the pointer is the same
+	bool IsShowingItem(const UItemBase* Item) const;
 	
 	virtual const UE::FieldNotification::IClassDescriptor* GetClassDescriptor() const {
 		return GetClassDescriptor();
@@ -37,9 +48,19 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "InventorySlot")
 	TSubclassOf<UCpp_WGT_InventoryToolTip> ToolTipClass;
 
+	// Only set as the slot's tooltip while the slot shows an item, empty slots have none
+	UPROPERTY(Transient)
+	UCpp_WGT_InventoryToolTip* ItemToolTip;
+
 	UPROPERTY(VisibleAnywhere, Category = "InventorySlot")
 	UItemBase* ItemReference;
 
+	UPROPERTY(VisibleAnywhere, Category = "InventorySlot")
+	UCpp_AC_Inventory* InventoryReference;
+
+	UPROPERTY(VisibleAnywhere, Category = "InventorySlot")
+	int32 SlotIndex = INDEX_NONE;
+
 	UPROPERTY(VisibleAnywhere, Category = "InventorySlot", meta = (BindWidget))
 	UBorder* Border_Item;
 	
@@ -49,6 +70,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "InventorySlot", meta = (BindWidget))
 	UTextBlock* TXT_Quantity;
 
+	// Item and quantity the slot currently shows
+	FName DisplayedItemID;
+	int32 DisplayedQuantity = INDEX_NONE;
+
 	virtual void NativeOnInitialized() override;
 	virtual void NativeConstruct() override;
 	virtual void NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation) override;
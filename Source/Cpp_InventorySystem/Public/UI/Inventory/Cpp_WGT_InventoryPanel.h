@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "UI/Cpp_CachedText.h"
 #include "Cpp_WGT_InventoryPanel.generated.h"
 
 // Forward Declarations
@@ -12,6 +13,9 @@ class UTextBlock;
 class ACpp_InventorySystemCharacter;
 class UCpp_AC_Inventory;
 class UCpp_WGT_InventoryItemSlot;
+class UCpp_WGT_MainMenu;
+class UItemBase;
+struct FInventoryChangeSet;
 
 /**
  * 
@@ -22,9 +26,14 @@ class CPP_INVENTORYSYSTEM_API UCpp_WGT_InventoryPanel : public UUserWidget
 	GENERATED_BODY()	
 	
 public:
+	// Rebuilds every slot, reusing the slot widgets already created
 	UFUNCTION()
 	void RefreshInventory();
 
+	// An inactive panel (closed menu) only remembers that it is out of date and refreshes once it is active again
+	void SetPanelActive(const bool bActive);
+	FORCEINLINE void SetOwningMenu(UCpp_WGT_MainMenu* InOwningMenu) { OwningMenu = InOwningMenu; }
+
 	UPROPERTY(meta = (BindWidget))
 	UWrapBox* WB_InventoryPanel;
 	
@@ -45,9 +54,25 @@ public:
 
 
 protected:
+	// One slot widget per inventory slot, empty slots included. The ones past the last slot are kept for reuse.
+	UPROPERTY()
+	TArray<UCpp_WGT_InventoryItemSlot*> SlotWidgets;
+
+	TWeakObjectPtr<UCpp_WGT_MainMenu> OwningMenu;
+
+	bool bPanelActive = true;
+	bool bRefreshPending = false;
+
+	// Weight and capacity as last shown, the texts are only rebuilt when these change
+	TCpp_CachedValueText<TTuple<float, float>> WeightInfoText;
+	TCpp_CachedValueText<TTuple<int32, int32>> CapacityInfoText;
 
 	virtual void NativeOnInitialized() override;
+	virtual void NativeDestruct() override;
 	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
 
-	void SetInfoText() const;
+	void SetInfoText();
+
+	// Only the changed slots and the slots of changed stacks are updated unless the layout changed
+	void OnInventoryChanged(const FInventoryChangeSet& ChangeSet);
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "UI/Cpp_CachedText.h"
 #include "Cpp_WGT_InventoryToolTip.generated.h"
 
 class UCpp_WGT_InventoryItemSlot;
@@ -46,6 +47,16 @@ public:
 	UTextBlock* TXT_StackWeight;
 
 protected:
-
+	// The tooltip is constructed again every time it shows, hovering the same stack again leaves every text block alone
+	FCpp_CachedText ItemTypeText;
+	FCpp_CachedText ItemNameText;
+	FCpp_CachedText UsageText;
+	FCpp_CachedText DescriptionText;
+	TCpp_CachedValueText<float> DamageValueText;
+	TCpp_CachedValueText<float> ArmorRatingText;
+	TCpp_CachedValueText<float> StackWeightText;
+	TCpp_CachedValueText<int32> MaxStackSizeText;
+
+	virtual void NativeOnInitialized() override;
 	virtual void NativeConstruct() override;
 };
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid over the XY plane, hashed so only occupied cells cost memory.
+ * The grid only knows which cell each element was last put in, callers keep that cell and move the element when its
+ * location changes. Radius queries visit the cells overlapping the query square, so callers still check the exact distance.
+ */
+template<typename ElementType>
+class TCpp_SpatialHashGrid {
+public:
+	explicit TCpp_SpatialHashGrid(const float InCellSize = 200.0f) : CellSize(FMath::Max(InCellSize, 1.0f)) {}
+
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+	FORCEINLINE int32 GetNumCells() const { return Cells.Num(); }
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const {
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	// Returns the cell Element was put in, needed to move or remove it again
+	FIntPoint Add(const ElementType& Element, const FVector& Location) {
+		const FIntPoint Cell = GetCell(Location);
+		Cells.FindOrAdd(Cell).Add(Element);
+		return Cell;
+	}
+
+	void Remove(const ElementType& Element, const FIntPoint Cell) {
+		if (TArray<ElementType>* CellElements = Cells.Find(Cell)) {
+			CellElements->RemoveSingleSwap(Element, false);
+			if (CellElements->IsEmpty()) {
+				Cells.Remove(Cell);
+			}
+		}
+	}
+
+	// Returns the cell Element is in now, doesn't touch the grid when it stayed in OldCell
+	FIntPoint Move(const ElementType& Element, const FIntPoint OldCell, const FVector& NewLocation) {
+		const FIntPoint NewCell = GetCell(NewLocation);
+		if (NewCell != OldCell) {
+			Remove(Element, OldCell);
+			Cells.FindOrAdd(NewCell).Add(Element);
+		}
+		return NewCell;
+	}
+
+	// Calls Visit(const ElementType&) for every element in a cell overlapping the square around Location
+	template<typename VisitFuncType>
+	void ForEachNear(const FVector& Location, const float Radius, VisitFuncType&& Visit) const {
+		const FIntPoint MinCell = GetCell(Location - FVector(Radius, Radius, 0.0));
+		const FIntPoint MaxCell = GetCell(Location + FVector(Radius, Radius, 0.0));
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y) {
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X) {
+				if (const TArray<ElementType>* CellElements = Cells.Find(FIntPoint(X, Y))) {
+					for (const ElementType& Element : *CellElements) {
+						Visit(Element);
+					}
+				}
+			}
+		}
+	}
+
+	void Reset() { Cells.Reset(); }
+
+private:
+	float CellSize;
+	TMap<FIntPoint, TArray<ElementType>> Cells;
+};
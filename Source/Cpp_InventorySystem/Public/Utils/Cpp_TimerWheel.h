@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Identifies a scheduled timer, stays safe to use after the timer fired or was cancelled
+struct FCpp_TimerWheelHandle {
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	FORCEINLINE bool IsValid() const { return Index != INDEX_NONE; }
+	FORCEINLINE void Invalidate() { Index = INDEX_NONE; }
+
+	FORCEINLINE bool operator==(const FCpp_TimerWheelHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	FORCEINLINE bool operator!=(const FCpp_TimerWheelHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Hierarchical timer wheel. Scheduling, cancelling and firing a timer are O(1) no matter how many timers are
+ * running, and timers far in the future only get touched when their wheel turns over (once per 64 ticks,
+ * once per 4096 ticks, ...), not every tick.
+ * Timers live in a flat node array reused through a free list, so steady state use doesn't allocate.
+ * Time is quantized to TickInterval, a timer fires on the first tick at or after its expiry.
+ */
+template<typename PayloadType, int32 NumLevels = 4, int32 SlotBits = 6>
+class TCpp_TimerWheel {
+public:
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+
+	explicit TCpp_TimerWheel(const float InTickInterval = 1.0f / 60.0f) : TickInterval(FMath::Max(InTickInterval, UE_KINDA_SMALL_NUMBER)) {
+		for (int32 Level = 0; Level < NumLevels; ++Level) {
+			for (int32 Slot = 0; Slot < SlotsPerLevel; ++Slot) {
+				SlotHeads[Level][Slot] = INDEX_NONE;
+			}
+		}
+	}
+
+	// Fires Payload after Delay seconds, rounded up to the next tick
+	FCpp_TimerWheelHandle Schedule(const float Delay, const PayloadType& Payload) {
+		const uint64 DelayTicks = FMath::Max<uint64>(static_cast<uint64>(FMath::CeilToDouble(FMath::Max(Delay, 0.0f) / TickInterval)), 1);
+
+		int32 NodeIndex = FreeHead;
+		if (NodeIndex != INDEX_NONE) {
+			FreeHead = Nodes[NodeIndex].Next;
+		}
+		else {
+			NodeIndex = Nodes.AddDefaulted();
+		}
+
+		FNode& Node = Nodes[NodeIndex];
+		Node.Payload = Payload;
+		Node.StartTick = CurrentTick;
+		Node.ExpireTick = CurrentTick + DelayTicks;
+		Node.bActive = true;
+		LinkNode(NodeIndex);
+		++NumActive;
+
+		return {NodeIndex, Node.Serial};
+	}
+
+	// Stops the timer without firing it, returns false if it already fired or was cancelled
+	bool Cancel(FCpp_TimerWheelHandle& Handle) {
+		const bool bWasActive = IsActive(Handle);
+		if (bWasActive) {
+			UnlinkNode(Handle.Index);
+			FreeNode(Handle.Index);
+		}
+		Handle.Invalidate();
+		return bWasActive;
+	}
+
+	FORCEINLINE bool IsActive(const FCpp_TimerWheelHandle& Handle) const {
+		return Nodes.IsValidIndex(Handle.Index) && Nodes[Handle.Index].bActive && Nodes[Handle.Index].Serial == Handle.Serial;
+	}
+
+	// Seconds until the timer fires, 0 when it isn't active
+	float GetRemainingTime(const FCpp_TimerWheelHandle& Handle) const {
+		if (!IsActive(Handle)) {
+			return 0.0f;
+		}
+		const double RemainingTicks = static_cast<double>(Nodes[Handle.Index].ExpireTick - CurrentTick) - AccumulatedTime / TickInterval;
+		return static_cast<float>(FMath::Max(RemainingTicks, 0.0) * TickInterval);
+	}
+
+	// How far along the timer is, from 0 when scheduled to 1 when it fires
+	float GetElapsedFraction(const FCpp_TimerWheelHandle& Handle) const {
+		if (!IsActive(Handle)) {
+			return 0.0f;
+		}
+		const FNode& Node = Nodes[Handle.Index];
+		const double ElapsedTicks = static_cast<double>(CurrentTick - Node.StartTick) + AccumulatedTime / TickInterval;
+		return static_cast<float>(FMath::Clamp(ElapsedTicks / static_cast<double>(Node.ExpireTick - Node.StartTick), 0.0, 1.0));
+	}
+
+	FORCEINLINE PayloadType* Find(const FCpp_TimerWheelHandle& Handle) {
+		return IsActive(Handle) ? &Nodes[Handle.Index].Payload : nullptr;
+	}
+
+	FORCEINLINE int32 Num() const { return NumActive; }
+	FORCEINLINE bool IsEmpty() const { return NumActive == 0; }
+	FORCEINLINE float GetTickInterval() const { return TickInterval; }
+
+	// Moves time forward by DeltaTime and calls OnExpired(Handle, Payload) for every timer that fired.
+	// The timer is already inactive during the call, so OnExpired may schedule or cancel timers.
+	template<typename FuncType>
+	void Advance(const float DeltaTime, FuncType&& OnExpired) {
+		AccumulatedTime += DeltaTime;
+		const uint64 NumTicks = static_cast<uint64>(AccumulatedTime / TickInterval);
+		AccumulatedTime -= NumTicks * TickInterval;
+
+		for (uint64 Tick = 0; Tick < NumTicks; ++Tick) {
+			if (NumActive == 0) {
+				// Nothing to cascade or fire, the rest of the ticks can be skipped at once
+				CurrentTick += NumTicks - Tick;
+				return;
+			}
+			AdvanceTick(OnExpired);
+		}
+	}
+
+	void Reset() {
+		Nodes.Reset();
+		FreeHead = INDEX_NONE;
+		NumActive = 0;
+		for (int32 Level = 0; Level < NumLevels; ++Level) {
+			for (int32 Slot = 0; Slot < SlotsPerLevel; ++Slot) {
+				SlotHeads[Level][Slot] = INDEX_NONE;
+			}
+		}
+	}
+
+private:
+	struct FNode {
+		PayloadType Payload;
+		uint64 StartTick = 0;
+		uint64 ExpireTick = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		uint32 Serial = 0;
+		int32 Level = INDEX_NONE;
+		int32 Slot = INDEX_NONE;
+		bool bActive = false;
+	};
+
+	template<typename FuncType>
+	void AdvanceTick(FuncType& OnExpired) {
+		++CurrentTick;
+
+		// When a level wraps around, the next slot of the level above is due and its timers move down
+		for (int32 Level = 1; Level < NumLevels; ++Level) {
+			if ((CurrentTick & ((uint64(1) << (SlotBits * Level)) - 1)) != 0) {
+				break;
+			}
+			const int32 Slot = static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask);
+			int32 NodeIndex = SlotHeads[Level][Slot];
+			SlotHeads[Level][Slot] = INDEX_NONE;
+			while (NodeIndex != INDEX_NONE) {
+				const int32 NextIndex = Nodes[NodeIndex].Next;
+				LinkNode(NodeIndex);
+				NodeIndex = NextIndex;
+			}
+			if (Slot != 0) {
+				break;
+			}
+		}
+
+		// Timers scheduled from OnExpired always land in a later slot, so popping until the slot is empty terminates
+		const int32 Slot = static_cast<int32>(CurrentTick & SlotMask);
+		while (SlotHeads[0][Slot] != INDEX_NONE) {
+			const int32 NodeIndex = SlotHeads[0][Slot];
+			UnlinkNode(NodeIndex);
+			const FCpp_TimerWheelHandle Handle{NodeIndex, Nodes[NodeIndex].Serial};
+			PayloadType Payload = MoveTemp(Nodes[NodeIndex].Payload);
+			FreeNode(NodeIndex);
+			OnExpired(Handle, Payload);
+		}
+	}
+
+	void LinkNode(const int32 NodeIndex) {
+		FNode& Node = Nodes[NodeIndex];
+		// 0 for timers cascaded down on the tick they expire, they go to the level 0 slot that is fired next
+		const uint64 Delta = Node.ExpireTick > CurrentTick ? Node.ExpireTick - CurrentTick : 0;
+		const uint64 ExpireTick = CurrentTick + Delta;
+
+		int32 Level = 0;
+		while (Level < NumLevels - 1 && Delta >= (uint64(1) << (SlotBits * (Level + 1)))) {
+			++Level;
+		}
+		uint64 SlotTick = ExpireTick;
+		if (Delta >= (uint64(1) << (SlotBits * NumLevels))) {
+			// Beyond the range of the wheel, parked in the furthest slot and moved down again when it comes round
+			SlotTick = CurrentTick + (SlotMask << (SlotBits * Level));
+		}
+		const int32 Slot = static_cast<int32>((SlotTick >> (SlotBits * Level)) & SlotMask);
+
+		Node.Level = Level;
+		Node.Slot = Slot;
+		Node.Prev = INDEX_NONE;
+		Node.Next = SlotHeads[Level][Slot];
+		if (Node.Next != INDEX_NONE) {
+			Nodes[Node.Next].Prev = NodeIndex;
+		}
+		SlotHeads[Level][Slot] = NodeIndex;
+	}
+
+	void UnlinkNode(const int32 NodeIndex) {
+		FNode& Node = Nodes[NodeIndex];
+		if (Node.Prev != INDEX_NONE) {
+			Nodes[Node.Prev].Next = Node.Next;
+		}
+		else {
+			SlotHeads[Node.Level][Node.Slot] = Node.Next;
+		}
+		if (Node.Next != INDEX_NONE) {
+			Nodes[Node.Next].Prev = Node.Prev;
+		}
+	}
+
+	void FreeNode(const int32 NodeIndex) {
+		FNode& Node = Nodes[NodeIndex];
+		Node.Payload = PayloadType();
+		Node.bActive = false;
+		// Outstanding handles to the node stop matching it
+		++Node.Serial;
+		Node.Next = FreeHead;
+		FreeHead = NodeIndex;
+		--NumActive;
+	}
+
+	TArray<FNode> Nodes;
+	int32 SlotHeads[NumLevels][SlotsPerLevel];
+	int32 FreeHead = INDEX_NONE;
+	int32 NumActive = 0;
+
+	uint64 CurrentTick = 0;
+	double AccumulatedTime = 0.0;
+	float TickInterval;
+};
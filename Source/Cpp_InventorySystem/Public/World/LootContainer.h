@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Interfaces/InteractionInterface.h"
+#include "LootContainer.generated.h"
+
+class UCpp_AC_Inventory;
+class UCpp_LootTable;
+
+// A world actor holding any number of items in its own inventory, one actor and one physics body however many
+// stacks are inside. Used as the loot bag for multi item and death drops, interacting takes everything that fits.
+// With a loot table set the container only keeps its seed and the table until a player first focuses or opens it,
+// the inventory is created and rolled then and can be released back to the seed once the player walked away.
+UCLASS()
+class CPP_INVENTORYSYSTEM_API ALootContainer : public AActor, public IInteractionInterface
+{
+	GENERATED_BODY()
+
+public:
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	// Sets default values for this actor's properties
+	ALootContainer();
+
+	FORCEINLINE UStaticMeshComponent* GetContainerMesh() const { return ContainerMesh; }
+	FORCEINLINE void SetDestroyWhenEmpty(const bool bInDestroyWhenEmpty) { bDestroyWhenEmpty = bInDestroyWhenEmpty; }
+	// nullptr while the contents haven't been rolled
+	FORCEINLINE UCpp_AC_Inventory* GetContainerInventory() const { return ContainerInventory; }
+	// Creates the inventory and rolls the loot table into it the first time it is needed
+	UCpp_AC_Inventory* GetOrCreateContainerInventory();
+
+	// Sizes the inventory to hold exactly what is about to be moved in, loot bags are filled once and never added to
+	void ReserveCapacity(const int32 NumStacks, const float TotalWeight);
+
+	// Refreshes what the interaction widget shows, call after changing the contents
+	void UpdateInteractableData();
+
+	virtual void BeginFocus() override;
+	virtual void EndFocus() override;
+	virtual void BeginInteract() override;
+
+protected:
+	//=========================================================================================================================
+	// PROPERTIES & VARIABLES
+	//=========================================================================================================================
+
+	UPROPERTY(VisibleAnywhere, Category = "Container | Components")
+	UStaticMeshComponent* ContainerMesh;
+
+	UPROPERTY(VisibleInstanceOnly, Transient, Category = "Container | Components")
+	UCpp_AC_Inventory* ContainerInventory;
+
+	// Name, action and InteractionDuration shown for the container, the type is always Container
+	UPROPERTY(EditAnywhere, Category = "Container | Interaction")
+	FInteractableData InstanceInteractableData;
+
+	// Set for loot bags, they go away once they were emptied. Placed chests stay, even if they rolled nothing.
+	UPROPERTY(EditAnywhere, Category = "Container | Interaction")
+	bool bDestroyWhenEmpty;
+
+	UPROPERTY(EditAnywhere, Category = "Container | Inventory")
+	int32 InventorySlotsCapacity;
+
+	UPROPERTY(EditAnywhere, Category = "Container | Inventory")
+	float InventoryWeightCapacity;
+
+	// Rolled into the inventory when it is first needed, containers without a table start out empty
+	UPROPERTY(EditAnywhere, Category = "Container | Loot")
+	UCpp_LootTable* LootTable;
+
+	// 0 derives the seed from the actor name, so every placed container rolls differently but the same every time
+	UPROPERTY(EditAnywhere, Category = "Container | Loot")
+	int32 LootSeed;
+
+	// Seconds the rolled contents are kept after the container lost focus, unless a player took something they are
+	// released and rolled from the seed again next time. 0 keeps them forever.
+	UPROPERTY(EditAnywhere, Category = "Container | Loot", meta = (ClampMin = "0.0"))
+	float ContentsReleaseDelay;
+
+	// The contents are no longer what the seed rolls and have to be kept
+	bool bContentsModified;
+
+	FTimerHandle ContentsReleaseTimer;
+
+
+	//=========================================================================================================================
+	// FUNCTIONS
+	//=========================================================================================================================
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void Interact(ACpp_InventorySystemCharacter* PlayerChracter) override;
+
+	int32 GetLootSeed() const;
+	void ReleaseContents();
+};
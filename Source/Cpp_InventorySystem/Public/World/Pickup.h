@@ -9,6 +9,7 @@
 
 class UItemBase;
 class UDataTable;
+struct FItemData;
 
 // Parents should be Actor and InteractionInterface which exists in Interface folder
 UCLASS()
@@ -33,8 +34,17 @@ public:
 
 	void InitializeDrop(UItemBase* ItemToDrop, const int32 InQuantity);
 
+	// Initializes a placed pickup from its row handle or catalog ID unless it already has its item.
+	// Placed pickups are initialized through the spawn queue, which does the ones within reach of a player right away:
+	// until then a queued pickup has no mesh or collision and can't be traced, let alone focused.
+	void EnsureInitialized();
+
 	FORCEINLINE UItemBase* GetItemData() const { return ItemReference; }
 
+	// Moves as much of Other's stack into this one as MaxStackSize allows, Other is destroyed once it is empty.
+	// Returns the quantity moved.
+	int32 AbsorbPickup(APickup* Other);
+
 	virtual void BeginFocus() override;
 	virtual void EndFocus() override;
 
@@ -58,16 +68,23 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Pickup | Item Initialization")
 	FDataTableRowHandle ItemRowHandle;
 
+	// Used when no row handle is set, the item is looked up in the cooked item catalog instead of a data table
+	UPROPERTY(EditAnywhere, Category = "Pickup | Item Initialization")
+	FName CatalogItemID;
+
 	//=========================================================================================================================
 	// FUNCTIONS
 	//=========================================================================================================================
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void Interact(ACpp_InventorySystemCharacter* PlayerChracter) override;
 
 	void UpdateInteractableData();
 
+	void InitializeFromItemData(const TSubclassOf<UItemBase> BaseClass, const FItemData& ItemData, const int32 InQuantity);
+
 	UFUNCTION()
 	void TakePickup(const ACpp_InventorySystemCharacter* Taker);
 